@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_ANIM_H_
+#define INC_ANIM_H_
+
+#include "common.h"
+
+/******************************************************************************
+ * The animation of a drop is a state machine with a deadline for each frame.
+ * The deadline is compared with the current time of the input loop, so the
+ * input is processed while the animation is playing. The times are given in
+ * milliseconds of a monotonic clock.
+ *
+ * A delay of 0 disables the animation, so each frame is due immediately.
+ *****************************************************************************/
+
+#ifdef DEBUG
+
+#define ANIM_DELAY_MS 800
+
+#else
+
+#define ANIM_DELAY_MS 200
+
+#endif
+
+/******************************************************************************
+ * The frames of the animation of a drop.
+ *****************************************************************************/
+
+typedef enum e_anim_state {
+
+	//
+	// There is no animation running.
+	//
+	ANIM_IDLE,
+
+		//
+		// The drop area was moved to the adjusted position.
+		//
+		ANIM_MOVE,
+
+		//
+		// The drop area was dropped, but the blocks are not removed.
+		//
+		ANIM_DROP
+} e_anim_state;
+
+/******************************************************************************
+ * The definition of the animation struct.
+ *****************************************************************************/
+
+typedef struct s_anim {
+
+	e_anim_state state;
+
+	//
+	// The duration of a frame and the deadline of the current frame.
+	//
+	long delay;
+
+	long deadline;
+
+} s_anim;
+
+#define anim_is_running(a) ((a)->state != ANIM_IDLE)
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void anim_init(s_anim *anim, const long delay);
+
+long anim_now();
+
+void anim_start(s_anim *anim, const e_anim_state state, const long now);
+
+void anim_stop(s_anim *anim);
+
+bool anim_is_due(const s_anim *anim, const long now);
+
+int anim_timeout(const s_anim *anim, const long now);
+
+#endif /* INC_ANIM_H_ */
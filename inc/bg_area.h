@@ -27,7 +27,8 @@
 
 #include "common.h"
 #include "colors.h"
+#include "cells.h"
 
-void bg_area_print_pixel(WINDOW *win, const s_point *pixel, const t_block color);
+void bg_area_print_pixel(s_cells *cells, const s_point *pixel, const t_block color);
 
 #endif /* INC_BG_AREA_H_ */
@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_BITBOARD_H_
+#define INC_BITBOARD_H_
+
+#include <stdint.h>
+
+#include "blocks.h"
+
+/******************************************************************************
+ * A bitboard is a compact representation of the occupancy of a 2-dimensional
+ * array of blocks. Each row consists of one or more machine words and each bit
+ * of a word represents a column. The bit is set if the block is not empty.
+ *
+ * Column c of a row is bit (c % WORD_BITS) of word (c / WORD_BITS). Bits
+ * beyond the number of columns are always 0.
+ *****************************************************************************/
+
+typedef uint64_t t_word;
+
+#define WORD_BITS 64
+
+typedef struct s_bitboard {
+
+	//
+	// The words of all rows.
+	//
+	t_word *words;
+
+	//
+	// The number of words of a row.
+	//
+	int row_words;
+
+	//
+	// The allocated dimension.
+	//
+	s_point dim;
+
+} s_bitboard;
+
+/******************************************************************************
+ * Macros to access the rows and bits of a bitboard.
+ *****************************************************************************/
+
+#define bitboard_num_words(c) (((c) + WORD_BITS - 1) / WORD_BITS)
+
+#define bitboard_row(b,r) (&(b)->words[(r) * (b)->row_words])
+
+#define bitboard_word(b,r,c) bitboard_row(b,r)[(c) / WORD_BITS]
+
+#define bitboard_bit(c) ((t_word) 1 << ((c) % WORD_BITS))
+
+#define bitboard_set(b,r,c) bitboard_word(b,r,c) |= bitboard_bit(c)
+
+#define bitboard_unset(b,r,c) bitboard_word(b,r,c) &= ~bitboard_bit(c)
+
+#define bitboard_is_set(b,r,c) ((bitboard_word(b,r,c) & bitboard_bit(c)) != 0)
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void bitboard_create(s_bitboard *bb, const int rows, const int cols);
+
+void bitboard_free(s_bitboard *bb);
+
+void bitboard_clear(s_bitboard *bb);
+
+void bitboard_from_blocks(s_bitboard *bb, const s_blocks *blocks, const s_point *dim);
+
+bool bitboard_row_fits(const s_bitboard *bb, const int row, const int col, const t_word mask);
+
+bool bitboard_fits(const s_bitboard *bb, const s_bitboard *shape, const s_point *dim, const s_point *idx);
+
+int bitboard_anchors(const s_bitboard *bb, const s_point *dim, const s_bitboard *shape, const s_point *shape_dim, s_bitboard *anchors);
+
+bool bitboard_first(const s_bitboard *bb, s_point *idx);
+
+void bitboard_normalize(s_bitboard *bb, const s_point *dim, s_point *norm_dim);
+
+#endif /* INC_BITBOARD_H_ */
@@ -33,16 +33,96 @@
 
 typedef short t_block;
 
+/******************************************************************************
+ * The definition of color indices. They are used as an index for an array with
+ * color pairs. The definitions do not depend on ncurses, so they can be used
+ * by the engine without a terminal.
+ *****************************************************************************/
+
+#define CLR_NONE        0
+
+//
+// Normal colors
+//
+#define CLR_RED__N      1
+#define CLR_GREE_N      2
+#define CLR_BLUE_N      3
+#define CLR_YELL_N      4
+
+//
+// Light colors
+//
+#define CLR_RED__L      5
+#define CLR_GREE_L      6
+#define CLR_BLUE_L      7
+#define CLR_YELL_L      8
+
+//
+// To get the light color from a normal color, simply add 4
+//
+#define colors_get_light(c) (c) + 4
+
+//
+// Background chess pattern colors
+//
+#define CLR_GREY_DARK_  9
+#define CLR_GREY_MID__ 10
+#define CLR_GREY_LIGHT 11
+
+//
+// A random normal color, from a random number generator.
+//
+#define colors_random_color(r) (rng_int((r), 4) + 1)
+
+/******************************************************************************
+ * The blocks of an area are stored in a single allocation. The rows are stored
+ * one after the other (row-major) and each row starts at an aligned address.
+ * The stride is the number of t_block elements from the start of one row to
+ * the start of the next row, which includes the padding at the end of the row.
+ *****************************************************************************/
+
+//
+// The alignment of the rows in bytes.
+//
+#define BLOCKS_ALIGN 32
+
+typedef struct s_blocks {
+
+	//
+	// The data of all rows.
+	//
+	t_block *data;
+
+	//
+	// The number of t_block elements of a row including the padding.
+	//
+	int stride;
+
+	//
+	// The allocated dimension.
+	//
+	s_point dim;
+
+} s_blocks;
+
+//
+// The macros return a pointer to the first block of a row and the block with
+// a given row and column. The block can be read and written.
+//
+#define blocks_row(b,r) (&(b)->data[(r) * (b)->stride])
+
+#define blocks_at(b,r,c) ((b)->data[(r) * (b)->stride + (c)])
+
 /******************************************************************************
  * Functions and macros
  *****************************************************************************/
 
-t_block** blocks_create(const int rows, const int cols);
+void blocks_create(s_blocks *blocks, const int rows, const int cols);
 
-void blocks_free(t_block **blocks, const int rows);
+void blocks_free(s_blocks *blocks);
 
-void blocks_set(t_block **blocks, const s_point *dim, const t_block value);
+void blocks_set(s_blocks *blocks, const s_point *dim, const t_block value);
 
-void blocks_copy(t_block **from, t_block **to, const s_point *dim);
+void blocks_copy(const s_blocks *from, s_blocks *to, const s_point *dim);
 
 #endif /* INC_BLOCKS_H_ */
@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef INC_BLOCKS_SIMD_H_
+#define INC_BLOCKS_SIMD_H_
+
+#include <stdint.h>
+
+#include "blocks.h"
+
+/******************************************************************************
+ * The functions are kernels, that process a row of blocks. On x86 there are
+ * SSE2 and AVX2 implementations, which are selected at runtime depending on
+ * the cpu. On other platforms and on cpus without SSE2 a scalar
+ * implementation is used.
+ *****************************************************************************/
+
+void blocks_row_fill(t_block *row, const t_block value, const int num);
+
+uint64_t blocks_row_mask(const t_block *row, const int num);
+
+const char* blocks_simd_name();
+
+bool blocks_simd_use(const char *name);
+
+#endif /* INC_BLOCKS_SIMD_H_ */
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_CELLS_H_
+#define INC_CELLS_H_
+
+#include <ncurses.h>
+
+#include "common.h"
+
+/******************************************************************************
+ * The cell buffer contains the characters and the attributes (color pair and
+ * flags) of a window. The game writes into the buffer and the buffer is
+ * flushed to a render backend (see render.h). The flush compares the buffer
+ * with the previous frame and only writes the runs of changed cells.
+ *****************************************************************************/
+
+typedef struct s_cell {
+
+	wchar_t chr;
+
+	attr_t attr;
+
+} s_cell;
+
+/******************************************************************************
+ * The definition of the cell buffer struct.
+ *****************************************************************************/
+
+typedef struct s_cells {
+
+	//
+	// The dimension of the buffer, which is the size of the window.
+	//
+	s_point dim;
+
+	//
+	// The current frame and the frame, that was flushed before.
+	//
+	s_cell *cur;
+
+	s_cell *prev;
+
+	//
+	// The attribute of an empty cell.
+	//
+	attr_t bg;
+
+} s_cells;
+
+#define cells_get(c,r,i) (&(c)->cur[(r) * (c)->dim.col + (i)])
+
+#define cells_get_prev(c,r,i) (&(c)->prev[(r) * (c)->dim.col + (i)])
+
+#define cells_is_inside(c,r,i) ((r) >= 0 && (r) < (c)->dim.row && (i) >= 0 && (i) < (c)->dim.col)
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void cells_create(s_cells *cells, const int rows, const int cols, const attr_t bg);
+
+void cells_free(s_cells *cells);
+
+void cells_resize(s_cells *cells, const int rows, const int cols);
+
+void cells_clear(s_cells *cells);
+
+void cells_invalidate(s_cells *cells);
+
+void cells_copy(s_cells *to, const s_cells *from);
+
+void cells_set(s_cells *cells, const int row, const int col, const wchar_t chr, const attr_t attr);
+
+void cells_set_str(s_cells *cells, const int row, const int col, const wchar_t *str, const attr_t attr);
+
+bool cells_next_run(const s_cells *cells, const int row, int *start, int *end);
+
+#endif /* INC_CELLS_H_ */
@@ -27,80 +27,41 @@
 
 #include <ncurses.h>
 
-#include "blocks.h"
+#include "s_game_cfg.h"
+#include "cells.h"
 
 /******************************************************************************
- * The definition of color indices. They are used as an index for an array with
- * color pairs.
+ * Functions and macros
  *****************************************************************************/
 
-#define CLR_NONE        0
-
-//
-// Normal colors
-//
-#define CLR_RED__N      1
-#define CLR_GREE_N      2
-#define CLR_BLUE_N      3
-#define CLR_YELL_N      4
-
-//
-// Light colors
-//
-#define CLR_RED__L      5
-#define CLR_GREE_L      6
-#define CLR_BLUE_L      7
-#define CLR_YELL_L      8
-
-//
-// To get the light color from a normal color, simply add 4
-//
-#define colors_get_light(c) (c) + 4
-
-//
-// Background chess pattern colors
-//
-#define CLR_GREY_DARK_  9
-#define CLR_GREY_MID__ 10
-#define CLR_GREY_LIGHT 11
+#define colors_is_even(r,c) ((r) % 2) == ((c) % 2)
 
 /******************************************************************************
- * The enum defines the different forms of chess pattern.
+ * The chess class of a block describes its position in the chess pattern. It
+ * is a combination of flags: the block is an even block and the block is in
+ * an even square (only used by the double chess pattern). Areas without
+ * squares have a square dimension of 0.
  *****************************************************************************/
 
-typedef enum e_chess_type {
+#define CHESS_CLASS_EVEN_BLOCK  1
 
-	//
-	// Simple chess pattern with two light colors
-	//
-	CHESS_SIMPLE_LIGHT,
+#define CHESS_CLASS_EVEN_SQUARE 2
 
-		//
-		// Simple chess pattern with two dark colors
-		//
-		CHESS_SIMPLE_DARK,
+#define CHESS_CLASS_NUM 4
 
-		//
-		// Double chess pattern with three colors
-		//
-		CHESS_DOUBLE
-} e_chess_type;
+#define colors_chess_class(i,d) ((colors_is_even((i)->row, (i)->col) ? CHESS_CLASS_EVEN_BLOCK : 0) | ((d) > 0 && (colors_is_even((i)->row / (d), (i)->col / (d))) ? CHESS_CLASS_EVEN_SQUARE : 0))
 
-/******************************************************************************
- * Functions and macros
- *****************************************************************************/
-
-#define colors_is_even(r,c) ((r) % 2) == ((c) % 2)
+void colors_init();
 
-#define colors_random_color() (rand() % 4) + 1
+void colors_init_virtual();
 
-void colors_init();
+bool colors_pair_content(const short pair, short *fg, short *bg);
 
-void colors_normal_set_attr(WINDOW *win, const t_block da_color);
+attr_t colors_normal_attr(const t_block da_color);
 
-void colors_normal_end_attr(WINDOW *win);
+attr_t colors_end_attr();
 
-wchar_t colors_chess_attr_char(WINDOW *win, const t_block ga_color, const t_block da_color, const s_point *idx, const e_chess_type chess_type);
+const s_cell* colors_chess_cell(const t_block ga_color, const t_block da_color, const s_point *idx, const e_chess_type chess_type, const int square_dim);
 
 short color_default_bg();
 
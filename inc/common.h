@@ -57,6 +57,12 @@
 
 #endif
 
+//
+// Can be used for function parameters, that are never used, for example
+// parameters of callback functions.
+//
+#define UNUSED __attribute__((unused))
+
 /******************************************************************************
  * Definition of the print_error macro, that finishes the program after
  * printing the error message.
@@ -92,6 +98,8 @@
  * Macro definitions.
  *****************************************************************************/
 
+#define min(a,b) ((a) < (b) ? (a) : (b))
+
 #define max(a,b) ((a) > (b) ? (a) : (b))
 
 #define bool_str(b) (b) ? "true" : "false"
@@ -132,6 +140,8 @@ void log_fatal(FILE *stream, const char *fmt, ...);
 
 void* xmalloc(const size_t size);
 
+void* xmalloc_aligned(const size_t align, const size_t size);
+
 s_point strs_dim(const char *strs[]);
 
 void trim_r(char *str);
@@ -146,4 +156,6 @@ void fmt_pad(wchar_t *dst, const int size, const wchar_t pad, const wchar_t *fmt
 
 void fmt_center(wchar_t *dst, const int size, const wchar_t pad, const wchar_t *fmt, ...);
 
+double get_time();
+
 #endif /* INC_COMMON_H_ */
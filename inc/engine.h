@@ -0,0 +1,181 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_ENGINE_H_
+#define INC_ENGINE_H_
+
+#include "s_area.h"
+#include "s_game_cfg.h"
+
+/******************************************************************************
+ * The engine contains the state of a game and the functions to play it. It
+ * does not depend on ncurses, so it can be used without a terminal, for
+ * example to simulate games. Positions of the areas (pixels) are not used by
+ * the engine, moves are given by block indices.
+ *
+ * The engine struct is the context of a game. It owns all data of the game,
+ * so several games can be played concurrently, each with its own engine.
+ *****************************************************************************/
+
+#define ENGINE_HOME_MAX 3
+
+//
+// The return value of engine_apply_move() if the move is not possible.
+//
+#define ENGINE_ILLEGAL -1
+
+//
+// The value of the pickup index, if no home area is picked up.
+//
+#define ENGINE_PICKUP_UNDEF -1
+
+/******************************************************************************
+ * The definition of a home area of the engine.
+ *****************************************************************************/
+
+typedef struct s_engine_home {
+
+	//
+	// The area which can be dropped.
+	//
+	s_area area;
+
+	//
+	// A flag that says that the home area was successfully dropped.
+	//
+	bool droped;
+
+	//
+	// The normalized form of the area, which is computed on refilling. It is
+	// used to check whether the area can be dropped, without copying and
+	// normalizing the area.
+	//
+	s_bitboard norm;
+
+	s_point norm_dim;
+
+} s_engine_home;
+
+/******************************************************************************
+ * The definition of the engine struct.
+ *****************************************************************************/
+
+typedef struct s_engine {
+
+	//
+	// The configuration of the game and the data for the random functions.
+	//
+	const s_game_cfg *game_cfg;
+
+	s_game_data game_data;
+
+	//
+	// The seed of the current game and the random number generator, which
+	// is initialized with the seed.
+	//
+	uint32_t seed;
+
+	s_rng rng;
+
+	//
+	// The temporary data of the rules.
+	//
+	s_rules rules;
+
+	//
+	// The area where the home areas are dropped.
+	//
+	s_area game_area;
+
+	//
+	// The home areas.
+	//
+	int home_num;
+
+	s_engine_home home[ENGINE_HOME_MAX];
+
+	//
+	// The index of the home area, which is currently picked up, or
+	// ENGINE_PICKUP_UNDEF. The backup contains the blocks of the picked up
+	// home area.
+	//
+	int pickup_idx;
+
+	s_area backup;
+
+	//
+	// The normalized copy of a home area, that is dropped. It is used for the
+	// picked up home area and by engine_apply_move().
+	//
+	s_area drop_area;
+
+	//
+	// A bitboard with the dimension of the game area, for the legal positions
+	// of an area.
+	//
+	s_bitboard anchors;
+
+	//
+	// The score and the number of turns of the current game.
+	//
+	int score;
+
+	int turns;
+
+	//
+	// The flag indicates that none of the home areas can be dropped.
+	//
+	bool end;
+
+} s_engine;
+
+#define engine_is_end(e) ((e)->end)
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void engine_create(s_engine *engine, const s_game_cfg *game_cfg, const uint32_t seed);
+
+void engine_free(s_engine *engine);
+
+void engine_reset(s_engine *engine, const uint32_t seed);
+
+void engine_copy(s_engine *to, const s_engine *from);
+
+bool engine_refill(s_engine *engine, const bool force);
+
+int engine_home_anchors(const s_engine *engine, const int home_idx, s_bitboard *anchors);
+
+bool engine_can_drop_anywhere(s_engine *engine);
+
+void engine_drop(s_engine *engine, const s_area *drop_area, const s_point *idx);
+
+int engine_remove(s_engine *engine, const s_area *drop_area, const s_point *idx);
+
+bool engine_end_move(s_engine *engine, const int home_idx);
+
+int engine_apply_move(s_engine *engine, const int home_idx, const s_point *idx);
+
+#endif /* INC_ENGINE_H_ */
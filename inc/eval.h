@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_EVAL_H_
+#define INC_EVAL_H_
+
+#include "engine.h"
+
+/******************************************************************************
+ * The evaluator scores the legal moves of the home areas of an engine. A move
+ * is dropped on a copy of the game area and the rules are applied. The score
+ * is a weighted sum of the removed blocks and the quality of the resulting
+ * game area.
+ *****************************************************************************/
+
+typedef struct s_eval_weights {
+
+	//
+	// The weight of a removed block.
+	//
+	int removed;
+
+	//
+	// The weight of a hole, which is an empty block, whose neighbors are all
+	// set or outside the game area.
+	//
+	int holes;
+
+	//
+	// The weight of a transition, which is a pair of neighbor blocks, where
+	// one is set and the other is empty. It measures the fragmentation.
+	//
+	int transitions;
+
+	//
+	// The weight of a legal position of the other home areas. The number of
+	// positions of a home area is limited by EVAL_FITS_MAX.
+	//
+	int fits;
+
+	//
+	// The weight of an other home area, that cannot be dropped anymore.
+	//
+	int no_fit;
+
+} s_eval_weights;
+
+#define EVAL_FITS_MAX 8
+
+//
+// The weights of the hint and a greedy evaluation, which counts only the
+// removed blocks.
+//
+extern const s_eval_weights eval_weights_default;
+
+extern const s_eval_weights eval_weights_greedy;
+
+/******************************************************************************
+ * The scratch data of the evaluator. The evaluator is created for a game
+ * configuration and can be used for all engines of that configuration.
+ *****************************************************************************/
+
+typedef struct s_eval {
+
+	//
+	// The copy of the game area, on which the move is dropped, and the rules
+	// data for the copy.
+	//
+	s_area scratch;
+
+	s_rules rules;
+
+	//
+	// The normalized home area, that is evaluated.
+	//
+	s_area drop_area;
+
+	//
+	// The legal positions of the home area and of the other home areas.
+	//
+	s_bitboard anchors;
+
+	s_bitboard fits;
+
+} s_eval;
+
+/******************************************************************************
+ * The best move of an evaluation.
+ *****************************************************************************/
+
+typedef struct s_eval_move {
+
+	int home_idx;
+
+	s_point idx;
+
+	int removed;
+
+	int score;
+
+} s_eval_move;
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void eval_create(s_eval *eval, const s_game_cfg *game_cfg);
+
+void eval_free(s_eval *eval);
+
+int eval_holes(const s_bitboard *bb, const s_point *dim);
+
+int eval_transitions(const s_bitboard *bb, const s_point *dim);
+
+bool eval_best_move(s_eval *eval, const s_engine *engine, const s_eval_weights *weights, s_eval_move *move);
+
+#endif /* INC_EVAL_H_ */
@@ -27,14 +27,17 @@
 
 #include "common.h"
 #include "s_status.h"
+#include "vterm.h"
 
 void game_init();
 
+void game_init_vterm(s_vterm *vterm);
+
 void game_free();
 
-void game_create_game(const s_status *status);
+void game_create_game(s_status *status, const uint32_t seed);
 
-void game_free_game(const s_status *status);
+void game_free_game(s_status *status);
 
 s_point game_get_game_area_size();
 
@@ -52,11 +55,11 @@ void game_process_event_move_old(s_status *status, const int row, const int col)
 
 bool game_event_drop(s_status *status);
 
-void game_do_center(const s_status *status);
+void game_do_center(s_status *status);
 
-void game_reset(s_status *status);
+void game_reset(s_status *status, const uint32_t seed);
 
-void game_win_refresh();
+void game_win_refresh(const s_status *status);
 
 void game_process_event_undo_pickup(s_status *status);
 
@@ -68,4 +71,18 @@ void game_process_do_pickup(s_status *status, const s_point *event);
 
 void game_event_move(s_status *status, const s_point *event);
 
+void game_event_hint(s_status *status);
+
+bool game_hint_update(s_status *status);
+
+bool game_anim_is_running();
+
+bool game_anim_tick(s_status *status);
+
+void game_anim_finish(s_status *status);
+
+int game_timeout();
+
+void game_set_anim_delay(const long delay);
+
 #endif /* INC_GAME_H_ */
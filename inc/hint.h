@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HINT_H_
+#define INC_HINT_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "engine.h"
+#include "solver.h"
+
+/******************************************************************************
+ * The hint searches the best move of the current game with the solver on a
+ * background thread, so a deep search does not block the input. Each change
+ * of the game is a new request, which cancels the running search. The result
+ * is fetched by the UI thread without waiting. A finished search is signaled
+ * with an eventfd, which wakes the event loop.
+ *****************************************************************************/
+
+/******************************************************************************
+ * The states of the hint, which are shown in the info area.
+ *****************************************************************************/
+
+typedef enum e_hint_state {
+
+	//
+	// The search for the current request is running.
+	//
+	HINT_SEARCHING,
+
+		//
+		// The best move of the current request was found.
+		//
+		HINT_READY,
+
+		//
+		// There is no move for the current request.
+		//
+		HINT_NONE
+} e_hint_state;
+
+/******************************************************************************
+ * The definition of the hint struct. The request and the result are protected
+ * by the mutex. The engine and the solver are only used by the worker.
+ *****************************************************************************/
+
+typedef struct s_hint {
+
+	//
+	// The flag is set if the worker was started, so a hint, that was never
+	// created, can be freed.
+	//
+	bool started;
+
+	pthread_t thread;
+
+	pthread_mutex_t mutex;
+
+	pthread_cond_t cond;
+
+	//
+	// The copy of the game of the last request and the copy, that is searched
+	// by the worker.
+	//
+	s_engine request;
+
+	s_engine engine;
+
+	s_solver solver;
+
+	//
+	// The generation is incremented by each request. The worker compares it
+	// with the generation of its search to detect outdated results.
+	//
+	unsigned int gen;
+
+	unsigned int done_gen;
+
+	//
+	// The flag is set by a new request and stops the running search.
+	//
+	atomic_bool cancel;
+
+	bool stop;
+
+	//
+	// The result of the last finished search.
+	//
+	bool found;
+
+	s_eval_move move;
+
+	//
+	// The eventfd, which is signaled if a result is stored.
+	//
+	int fd;
+
+} s_hint;
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void hint_create(s_hint *hint, const s_engine *engine);
+
+void hint_free(s_hint *hint);
+
+void hint_request(s_hint *hint, const s_engine *engine);
+
+e_hint_state hint_get(s_hint *hint, s_eval_move *move);
+
+#endif /* INC_HINT_H_ */
@@ -27,35 +27,25 @@
 
 #include <ncurses.h>
 
-#include "s_area.h"
-#include "s_status.h"
+#include "engine.h"
+#include "cells.h"
 
-int home_area_get_idx(const s_point *pixel);
+int home_area_get_idx(const s_engine *engine, const s_point *pixel);
 
-bool home_area_can_drop_anywhere(s_area *area);
+int home_area_drop(s_engine *engine);
 
-void home_area_mark_drop();
+bool home_area_pickup(s_engine *engine, const s_point *pixel);
 
-bool home_area_refill(const s_game_cfg *game_cfg, const bool force);
+void home_area_undo_pickup(s_engine *engine);
 
-bool home_area_pickup(s_area *area, const s_point *pixel);
+void home_area_print(s_cells *cells, const s_engine *engine);
 
-void home_area_undo_pickup();
+void home_area_print_pixel(s_cells *cells, const s_engine *engine, const int idx, const s_point *pixel, const s_point *block, const t_block da_color);
 
-void home_area_print(WINDOW *win, const s_status *status);
+s_point home_area_get_size(const s_engine *engine, const bool horizontal);
 
-void home_area_print_pixel(WINDOW *win, const s_status *status, const s_point *pixel, const t_block da_color);
+void home_area_layout(s_engine *engine, const s_point *pos, const bool horizontal);
 
-void home_area_reset(const s_game_cfg *game_cfg);
-
-void home_area_create_game(const s_game_cfg *game_cfg);
-
-void home_area_free_game();
-
-s_point home_area_get_size(const bool horizontal);
-
-void home_area_layout(const s_point *pos, const bool horizontal);
-
-bool home_area_next_unused(s_point *pos);
+bool home_area_next_unused(const s_engine *engine, s_point *pos);
 
 #endif /* INC_HOME_AREA_H_ */
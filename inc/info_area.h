@@ -27,26 +27,27 @@
 
 #include "common.h"
 #include "colors.h"
+#include "cells.h"
 #include "nuzzle.h"
 #include "s_status.h"
 
 void info_area_init();
 
-void info_area_update_score_turns(WINDOW *win, const s_status *status, const int add_2_score);
+void info_area_update_score_turns(s_cells *cells, const s_status *status, const int add_2_score);
 
-void info_area_new_turn(WINDOW *win, const s_status *status);
+void info_area_new_turn(s_cells *cells, const s_status *status);
 
 void info_area_set_pos(const int row, const int col);
 
 s_point info_area_get_size();
 
-void info_area_print(WINDOW *win, const s_status *status);
+void info_area_print(s_cells *cells, const s_status *status);
 
-bool info_area_contains(const s_point *pixel);
+void info_area_print_pixel(s_cells *cells, const s_point *pixel, const t_block color);
 
-void info_area_print_pixel(WINDOW *win, const s_point *pixel, const t_block color);
+void info_area_set_end(s_cells *cells, const s_status *status);
 
-void info_area_set_end(WINDOW *win, const s_status *status);
+bool info_area_update_hint(s_cells *cells, const s_status *status, const e_hint_state state);
 
 /******************************************************************************
  * The function declarations for unit tests
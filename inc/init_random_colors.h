@@ -27,8 +27,8 @@
 
 #include "s_game_cfg.h"
 
-void init_random_colors_setup(const char *data);
+void init_random_colors_setup(s_game_data *game_data, const char *data);
 
-void init_random_colors(const s_game_cfg *game_cfg, t_block **blocks);
+void init_random_colors(const s_game_cfg *game_cfg, const s_game_data *game_data, s_rng *rng, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim);
 
 #endif /* INC_INIT_RANDOM_COLORS_H_ */
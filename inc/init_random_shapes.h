@@ -54,14 +54,33 @@ typedef struct s_shape {
 	//
 	short blocks[SHAPE_DIM][SHAPE_DIM];
 
+	//
+	// The normalized form of the shape, which is computed once after the
+	// shape is read. The upper left corner and the dimension of the bounding
+	// box of the defined blocks and the row masks of the normalized shape.
+	//
+	s_point ul;
+
+	s_point dim;
+
+	t_word mask[SHAPE_DIM];
+
+	//
+	// The list of the defined blocks, relative to the upper left corner of
+	// the bounding box.
+	//
+	s_point cells[SHAPE_DIM * SHAPE_DIM];
+
+	int num_cells;
+
 } s_shape;
 
 /*******************************************************************************
  * Definition of functions.
  ******************************************************************************/
 
-void init_random_shapes_read(const char *path);
+void init_random_shapes_read(s_game_data *game_data, const char *path);
 
-void init_random_shapes(const s_game_cfg *game_cfg, t_block **blocks);
+void init_random_shapes(const s_game_cfg *game_cfg, const s_game_data *game_data, s_rng *rng, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim);
 
 #endif /* INC_INIT_RANDOM_SHAPES_H_ */
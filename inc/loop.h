@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_LOOP_H_
+#define INC_LOOP_H_
+
+#include <signal.h>
+
+#include "common.h"
+
+/******************************************************************************
+ * The event loop waits with poll() for the input of the terminal, a timer, the
+ * signals and the completion of a background worker. The timer is a timerfd,
+ * the signals are received with a signalfd and the worker signals an eventfd.
+ * So each source wakes the loop without busy waiting.
+ *
+ * The signals have to be blocked in all threads, so the loop has to be created
+ * before any thread is started.
+ *****************************************************************************/
+
+//
+// The flags of the events, that are returned by loop_wait().
+//
+#define LOOP_INPUT  (1 << 0)
+
+#define LOOP_TIMER  (1 << 1)
+
+#define LOOP_RESIZE (1 << 2)
+
+#define LOOP_TERM   (1 << 3)
+
+#define LOOP_WORKER (1 << 4)
+
+/******************************************************************************
+ * The definition of the loop struct.
+ *****************************************************************************/
+
+typedef struct s_loop {
+
+	//
+	// The file descriptors of the timer and the signals.
+	//
+	int fd_timer;
+
+	int fd_signal;
+
+	//
+	// The signals, which are received with the signalfd.
+	//
+	sigset_t mask;
+
+} s_loop;
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void loop_create(s_loop *loop);
+
+void loop_free(s_loop *loop);
+
+void loop_block_resize(const s_loop *loop, const bool block);
+
+void loop_set_timer(const s_loop *loop, const int timeout);
+
+int loop_wait(const s_loop *loop, const int fd_worker);
+
+#endif /* INC_LOOP_H_ */
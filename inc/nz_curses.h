@@ -38,6 +38,8 @@ void nzc_win_del(WINDOW *win);
 
 void nzc_win_refresh(WINDOW *win);
 
+void nzc_resize();
+
 bool nzc_win_is_inside(WINDOW *win, const int row, const int col);
 
 int nzc_menu_cur_item_idx(MENU *menu);
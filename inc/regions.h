@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_REGIONS_H_
+#define INC_REGIONS_H_
+
+#include "s_area.h"
+
+/******************************************************************************
+ * The region map assigns each pixel (terminal character) of the game window
+ * to the area, that owns it. For the game area and the home areas, the block
+ * of the pixel is stored as well. The map is rebuilt with each layout, so a
+ * pixel can be redrawn with a single lookup.
+ *****************************************************************************/
+
+typedef enum e_region_type {
+
+	//
+	// The pixel is not part of an area.
+	//
+	REGION_BG,
+
+		//
+		// The pixel is part of the game area.
+		//
+		REGION_GAME,
+
+		//
+		// The pixel is part of the info area.
+		//
+		REGION_INFO,
+
+		//
+		// The pixel is part of a home area.
+		//
+		REGION_HOME
+} e_region_type;
+
+/******************************************************************************
+ * The definition of a region of a pixel.
+ *****************************************************************************/
+
+typedef struct s_region {
+
+	e_region_type type;
+
+	//
+	// The index of the home area or -1.
+	//
+	int idx;
+
+	//
+	// The block of the area, that contains the pixel.
+	//
+	s_point block;
+
+} s_region;
+
+/******************************************************************************
+ * The definition of the region map struct.
+ *****************************************************************************/
+
+typedef struct s_regions {
+
+	//
+	// The dimension of the map, which is the size of the window.
+	//
+	s_point dim;
+
+	s_region *map;
+
+} s_regions;
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void regions_free(s_regions *regions);
+
+void regions_reset(s_regions *regions, const s_point *dim);
+
+void regions_add_rect(s_regions *regions, const e_region_type type, const s_point *pos, const s_point *size);
+
+void regions_add_area(s_regions *regions, const e_region_type type, const int idx, const s_area *area);
+
+const s_region* regions_get(const s_regions *regions, const s_point *pixel);
+
+#endif /* INC_REGIONS_H_ */
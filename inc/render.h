@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_RENDER_H_
+#define INC_RENDER_H_
+
+#include <ncurses.h>
+
+#include "common.h"
+#include "cells.h"
+#include "vterm.h"
+
+/******************************************************************************
+ * The render backend receives the runs of changed cells of a cell buffer. The
+ * ncurses backend writes them to a window, the virtual terminal backend
+ * records them in memory. The backend is selected at startup and the game
+ * does not know which one is used.
+ *****************************************************************************/
+
+typedef struct s_render_ops {
+
+	//
+	// The name of the backend for logging.
+	//
+	const char *name;
+
+	//
+	// The function writes a run of cells, starting at a position.
+	//
+	void (*put)(void *target, const int row, const int col, const s_cell *cells, const int num);
+
+	//
+	// The function shows the written cells, which finishes a frame.
+	//
+	void (*show)(void *target);
+
+	//
+	// The function returns the dimension of the target.
+	//
+	s_point (*get_dim)(const void *target);
+
+} s_render_ops;
+
+/******************************************************************************
+ * The definition of the render struct, which is a backend with its target.
+ *****************************************************************************/
+
+typedef struct s_render {
+
+	const s_render_ops *ops;
+
+	void *target;
+
+} s_render;
+
+#define render_get_dim(r) ((r)->ops->get_dim((r)->target))
+
+#define render_show(r) ((r)->ops->show((r)->target))
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void render_curses(s_render *render, WINDOW *win);
+
+void render_vterm(s_render *render, s_vterm *vterm);
+
+int render_flush(s_render *render, s_cells *cells);
+
+#endif /* INC_RENDER_H_ */
@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_RNG_H_
+#define INC_RNG_H_
+
+#include <stdint.h>
+
+#include "common.h"
+
+/******************************************************************************
+ * The random number generator is a xoshiro256** generator. Each game has its
+ * own generator, so the games are reproducible by their seed and games can be
+ * played concurrently without a shared state.
+ *****************************************************************************/
+
+typedef struct s_rng {
+
+	uint64_t state[4];
+
+} s_rng;
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void rng_seed(s_rng *rng, const uint32_t seed);
+
+uint64_t rng_next(s_rng *rng);
+
+int rng_int(s_rng *rng, const int num);
+
+uint32_t rng_new_seed();
+
+#endif /* INC_RNG_H_ */
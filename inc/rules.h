@@ -32,7 +32,8 @@
  ******************************************************************************/
 
 //
-// The dimension of a square on the game area for the squares-lines rules.
+// The default dimension of a square on the game area for the squares-lines
+// rules. It can be configured for each game.
 //
 #define RULES_SQUARE_DIM 3
 
@@ -41,18 +42,62 @@
 //
 #define RULES_MARKER 1
 
+/*******************************************************************************
+ * The struct contains the temporary data of the rules. Each game has its own
+ * rules data, so the rules of different games can be applied concurrently.
+ ******************************************************************************/
+
+typedef struct s_rules {
+
+	//
+	// The visited blocks of the labeling of the components and the visited
+	// squares. A block or square was visited in the current call if its
+	// value is the current stamp.
+	//
+	unsigned int *visited;
+
+	unsigned int *visited_squares;
+
+	unsigned int stamp;
+
+	//
+	// The footprint of the last drop, which are the blocks of the area, that
+	// were set by the drop, as indices (row * dim.col + col).
+	//
+	int *footprint;
+
+	//
+	// The blocks of the current component as indices (row * dim.col + col).
+	//
+	int *component;
+
+	//
+	// The indices of the complete rows and columns, that were found after a
+	// drop.
+	//
+	int *full_rows;
+
+	int *full_cols;
+
+	//
+	// The indices of the fill counters of the complete squares.
+	//
+	int *full_squares;
+
+} s_rules;
+
 /*******************************************************************************
  * Function declarations.
  ******************************************************************************/
 
-void rules_create_game(const s_area *area);
+void rules_create_game(s_rules *rules, const s_area *area);
 
-void rules_free_game(const s_area *area);
+void rules_free_game(s_rules *rules);
 
-int rules_remove_lines(const s_area *area);
+int rules_remove_lines(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx);
 
-int rules_remove_squares_lines(const s_area *area);
+int rules_remove_squares_lines(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx);
 
-int rules_remove_neighbors(const s_area *area);
+int rules_remove_neighbors(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx);
 
 #endif /* INC_RULES_H_ */
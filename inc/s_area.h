@@ -25,10 +25,8 @@
 #ifndef INC_S_AREA_H_
 #define INC_S_AREA_H_
 
-#include <ncurses.h>
-
 #include "blocks.h"
-#include "colors.h"
+#include "bitboard.h"
 
 /******************************************************************************
  * The definition of the area struct.
@@ -42,7 +40,40 @@ typedef struct s_area {
 	//
 	// CLR_NONE, CLR_RED, CLR_GREEN, CLR_BLUE, CLR_YELLOW
 	//
-	t_block **blocks;
+	s_blocks blocks;
+
+	//
+	// The occupancy of the blocks. A bit is set if the corresponding block is
+	// not CLR_NONE. The functions of the s_area keep the bitboard in sync
+	// with the blocks. Code that writes the blocks directly has to call
+	// s_area_sync() afterwards.
+	//
+	s_bitboard bits;
+
+	//
+	// The number of blocks, that are not CLR_NONE, for each row and each
+	// column. They are maintained together with the bitboard.
+	//
+	int *row_fill;
+
+	int *col_fill;
+
+	//
+	// The area can be divided into squares of square_dim x square_dim blocks.
+	// If so, the number of blocks of each square is maintained as well. The
+	// lookup tables map a row / column to the row / column of its square. The
+	// value is -1 for blocks of the incomplete squares at the borders. The
+	// squares are only used if square_fill is not NULL.
+	//
+	int square_dim;
+
+	s_point square_num;
+
+	int *square_row;
+
+	int *square_col;
+
+	int *square_fill;
 
 	//
 	// The dimensions of the 2-dimensional array.
@@ -61,6 +92,17 @@ typedef struct s_area {
 
 } s_area;
 
+//
+// The macro returns the block of the area with the given row and column.
+//
+#define s_area_block(a,r,c) blocks_at(&(a)->blocks, r, c)
+
+//
+// The macro returns the index of the square fill counter for a square row and
+// column.
+//
+#define s_area_square_idx(a,r,c) ((r) * (a)->square_num.col + (c))
+
 /******************************************************************************
  * The functions for the s_area.
  *****************************************************************************/
@@ -89,7 +131,7 @@ bool s_area_move_inner_area(const s_area *outer_area, const s_area *inner_area,
 
 void s_area_get_block(const s_area *area, const s_point *pixel, s_point *block);
 
-void s_area_set_blocks(const s_area *area, const t_block value);
+void s_area_set_blocks(s_area *area, const t_block value);
 
 bool s_area_same_pos(const s_area *area, const int row, const int col);
 
@@ -97,18 +139,20 @@ void s_area_create(s_area *area, const s_point *dim, const s_point *size);
 
 void s_area_free(s_area *area);
 
-void s_area_get_eff_ul(const s_area *area, s_point *ul);
+void s_area_sync(s_area *area);
 
-void s_area_normalize(s_area *area);
+void s_area_remove_block(s_area *area, const int row, const int col);
 
-bool s_area_can_drop_anywhere(s_area *area, s_area *drop_area, s_point *idx);
+void s_area_create_squares(s_area *area, const int square_dim);
 
-bool s_area_drop(s_area *area, const s_point *idx, const s_area *drop_area, const bool do_drop);
+void s_area_get_eff_ul(const s_area *area, s_point *ul);
 
-void s_area_print_block(WINDOW *win, const s_area *area, const s_point *idx, const wchar_t ch);
+void s_area_normalize(s_area *area);
+
+int s_area_legal_anchors(const s_area *area, const s_area *drop_area, s_bitboard *anchors);
 
-void s_area_print_chess(WINDOW *win, const s_area *area, const e_chess_type chess_type);
+bool s_area_can_drop_anywhere(const s_area *area, const s_area *drop_area, s_bitboard *anchors, s_point *idx);
 
-void s_area_print_chess_pixel(WINDOW *win, const s_area *area, const s_point *pixel, const t_block da_color, const e_chess_type chess_type);
+bool s_area_drop(s_area *area, const s_point *idx, const s_area *drop_area, const bool do_drop);
 
 #endif /* INC_S_AREA_H_ */
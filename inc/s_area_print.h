@@ -0,0 +1,45 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_S_AREA_PRINT_H_
+#define INC_S_AREA_PRINT_H_
+
+#include <ncurses.h>
+
+#include "s_area.h"
+#include "s_game_cfg.h"
+#include "cells.h"
+
+/******************************************************************************
+ * The functions print a s_area to the cell buffer of a ncurses window. They
+ * are separated from the s_area functions, which do not depend on ncurses.
+ *****************************************************************************/
+
+void s_area_print_block(s_cells *cells, const s_area *area, const s_point *idx, const wchar_t ch, const attr_t attr);
+
+void s_area_print_chess(s_cells *cells, const s_area *area, const e_chess_type chess_type);
+
+void s_area_print_chess_pixel(s_cells *cells, const s_area *area, const s_point *pixel, const s_point *block_idx, const t_block da_color, const e_chess_type chess_type);
+
+#endif /* INC_S_AREA_PRINT_H_ */
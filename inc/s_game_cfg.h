@@ -27,6 +27,30 @@
 
 #include "common.h"
 #include "s_area.h"
+#include "rules.h"
+#include "rng.h"
+
+/******************************************************************************
+ * The enum defines the different forms of chess pattern.
+ *****************************************************************************/
+
+typedef enum e_chess_type {
+
+	//
+	// Simple chess pattern with two light colors
+	//
+	CHESS_SIMPLE_LIGHT,
+
+		//
+		// Simple chess pattern with two dark colors
+		//
+		CHESS_SIMPLE_DARK,
+
+		//
+		// Double chess pattern with three colors
+		//
+		CHESS_DOUBLE
+} e_chess_type;
 
 /******************************************************************************
  * The definition of the game types.
@@ -49,6 +73,31 @@
 
 #define TYPE_4_COLORS_STR "4-colors"
 
+/******************************************************************************
+ * The struct contains the data for the random functions, that fill the home
+ * areas. It is set from the data of the game configuration. Each game has its
+ * own data, so the struct is part of the engine and not of the configuration.
+ *****************************************************************************/
+
+struct s_shape;
+
+typedef struct s_game_data {
+
+	//
+	// The shapes of the shapes games, which are read from a file. The array
+	// is allocated.
+	//
+	struct s_shape *shapes;
+
+	int num_shapes;
+
+	//
+	// The probability of an empty block for the colors game.
+	//
+	int random;
+
+} s_game_data;
+
 /******************************************************************************
  * The definition of the s_game struct.
  *****************************************************************************/
@@ -101,6 +150,11 @@ struct s_game_cfg {
 	//
 	s_point drop_dim;
 
+	//
+	// The dimension of the squares for the squares-lines rules.
+	//
+	int square_dim;
+
 	//
 	// The number of home areas.
 	//
@@ -124,18 +178,21 @@ struct s_game_cfg {
 	//
 	// The function is called to set the data for the random functions.
 	//
-	void (*fct_ptr_set_data)(const char *data);
+	void (*fct_ptr_set_data)(s_game_data *game_data, const char *data);
 
 	//
 	// The function is called to remove blocks. It defines the rules for this
-	// game.
+	// game. The drop area and its index on the area are used to restrict the
+	// checks to the region of the last drop.
 	//
-	int (*fct_ptr_rules_remove)(const s_area *area);
+	int (*fct_ptr_rules_remove)(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx);
 
 	//
-	// The function is called to fill / refill the home areas.
+	// The function is called to fill / refill the home areas. Additionally
+	// the function sets the normalized bitboard of the blocks and its
+	// dimension. The random numbers are taken from the generator of the game.
 	//
-	void (*fct_ptr_init_random)(const s_game_cfg*, t_block**);
+	void (*fct_ptr_init_random)(const s_game_cfg*, const s_game_data*, s_rng*, s_blocks*, s_bitboard*, s_point*);
 
 };
 
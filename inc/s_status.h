@@ -25,7 +25,9 @@
 #ifndef INC_S_STATUS_H_
 #define INC_S_STATUS_H_
 
-#include "s_game_cfg.h"
+#include "engine.h"
+#include "eval.h"
+#include "hint.h"
 
 /******************************************************************************
  * The structure contains data that represent the status of the game.
@@ -52,6 +54,21 @@ typedef struct s_status {
 	//
 	const s_game_cfg *game_cfg;
 
+	//
+	// The engine with the data of the current game.
+	//
+	s_engine engine;
+
+	//
+	// The evaluator, which computes the hint for the current game.
+	//
+	s_eval eval;
+
+	//
+	// The hint, which searches the best move in the background.
+	//
+	s_hint hint;
+
 } s_status;
 
 //
@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_SIM_H_
+#define INC_SIM_H_
+
+#include "engine.h"
+#include "eval.h"
+#include "solver.h"
+
+/******************************************************************************
+ * The simulation plays complete games without a terminal. The moves are
+ * selected by a policy. The results of the games are collected in a
+ * statistics struct.
+ *****************************************************************************/
+
+typedef enum e_sim_policy {
+
+	//
+	// A random move of all legal moves.
+	//
+	SIM_POLICY_RANDOM,
+
+		//
+		// The first legal position of the first home area, that fits.
+		//
+		SIM_POLICY_FIRST_FIT,
+
+		//
+		// The move that removes the most blocks.
+		//
+		SIM_POLICY_GREEDY,
+
+		//
+		// The best move of the evaluator with the default weights.
+		//
+		SIM_POLICY_EVAL,
+
+		//
+		// The first move of the best path of the solver.
+		//
+		SIM_POLICY_SOLVER,
+
+		SIM_POLICY_NUM
+} e_sim_policy;
+
+/******************************************************************************
+ * The reasons why a simulated game ended.
+ *****************************************************************************/
+
+typedef enum e_sim_end {
+
+	//
+	// None of the home areas can be dropped.
+	//
+	SIM_END_NO_FIT,
+
+		//
+		// The maximum number of turns was reached.
+		//
+		SIM_END_MAX_TURNS,
+
+		SIM_END_NUM
+} e_sim_end;
+
+/******************************************************************************
+ * The options of a simulation. The beam width and the expect flag are used by
+ * the solver policy.
+ *****************************************************************************/
+
+typedef struct s_sim_opts {
+
+	e_sim_policy policy;
+
+	int beam;
+
+	bool expect;
+
+} s_sim_opts;
+
+/******************************************************************************
+ * The definition of the simulation struct. It contains the engine of the game
+ * and the scratch data of the policies.
+ *****************************************************************************/
+
+typedef struct s_sim {
+
+	s_engine engine;
+
+	s_sim_opts opts;
+
+	//
+	// The random number generator of the random policy. It is separated from
+	// the generator of the engine, so the home areas of a seed do not depend
+	// on the policy.
+	//
+	s_rng rng;
+
+	//
+	// The evaluator of the greedy and the eval policy.
+	//
+	s_eval eval;
+
+	//
+	// The solver of the solver policy. It is only created for this policy.
+	//
+	s_solver solver;
+
+	//
+	// The legal positions of a home area.
+	//
+	s_bitboard anchors;
+
+} s_sim;
+
+/******************************************************************************
+ * The result of a single game.
+ *****************************************************************************/
+
+typedef struct s_sim_game {
+
+	int score;
+
+	int turns;
+
+	e_sim_end end;
+
+} s_sim_game;
+
+/******************************************************************************
+ * The statistics of the simulated games. The scores of all games are stored
+ * by their game index to compute the distribution. The workers of a parallel
+ * run share the array of the scores, because each game has its own index.
+ *****************************************************************************/
+
+typedef struct s_sim_stats {
+
+	int games;
+
+	int max_games;
+
+	int *scores;
+
+	long turns;
+
+	int turns_min;
+
+	int turns_max;
+
+	long ends[SIM_END_NUM];
+
+} s_sim_stats;
+
+/******************************************************************************
+ * The number of games, that a worker takes at once.
+ *****************************************************************************/
+
+#define SIM_CHUNK 64
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+const char* sim_policy_str(const e_sim_policy policy);
+
+e_sim_policy sim_policy_parse(const char *str);
+
+const char* sim_end_str(const e_sim_end end);
+
+void sim_create(s_sim *sim, const s_game_cfg *game_cfg, const s_sim_opts *opts);
+
+void sim_free(s_sim *sim);
+
+bool sim_select_move(s_sim *sim, int *home_idx, s_point *idx);
+
+void sim_play_game(s_sim *sim, const uint32_t seed, const int max_turns, s_sim_game *game);
+
+void sim_stats_create(s_sim_stats *stats, const int max_games);
+
+void sim_stats_free(s_sim_stats *stats);
+
+void sim_stats_add(s_sim_stats *stats, const int game_idx, const s_sim_game *game);
+
+void sim_stats_merge(s_sim_stats *to, const s_sim_stats *from);
+
+void sim_run(const s_game_cfg *game_cfg, const s_sim_opts *opts, const uint32_t seed, const int max_turns, const int num_threads, s_sim_stats *stats);
+
+void sim_stats_print(FILE *stream, s_sim_stats *stats, const double seconds);
+
+#endif /* INC_SIM_H_ */
@@ -0,0 +1,194 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_SOLVER_H_
+#define INC_SOLVER_H_
+
+#include <stdatomic.h>
+
+#include "engine.h"
+#include "eval.h"
+
+/******************************************************************************
+ * The solver searches the orderings and positions of the home areas, that
+ * are not dropped, with a beam search. Each layer of the search drops one
+ * more home area. Only the best nodes of a layer are expanded and equal game
+ * areas, which are reached by different orderings, are merged by their hash.
+ *
+ * If all home areas are dropped, the next refill is unknown. Optionally the
+ * expected value of a random shape on the final game area is added.
+ *****************************************************************************/
+
+#define SOLVER_BEAM_DEFAULT 32
+
+//
+// The number of block values, that are used for the hashing.
+//
+#define SOLVER_COLORS 16
+
+/******************************************************************************
+ * A node of the search, which is a game area after a number of drops.
+ *****************************************************************************/
+
+typedef struct s_solver_node {
+
+	s_area area;
+
+	//
+	// The bit mask with the home areas, that are dropped.
+	//
+	int used;
+
+	//
+	// The number of removed blocks since the start of the search and the
+	// value of the node.
+	//
+	int removed;
+
+	int value;
+
+	//
+	// The first move of the path to the node.
+	//
+	s_eval_move first;
+
+} s_solver_node;
+
+/******************************************************************************
+ * A candidate for the next layer. The game area of a candidate is only
+ * created, if the candidate is selected.
+ *****************************************************************************/
+
+typedef struct s_solver_child {
+
+	int parent;
+
+	int home_idx;
+
+	s_point idx;
+
+	int removed;
+
+	int value;
+
+	uint64_t hash;
+
+} s_solver_child;
+
+/******************************************************************************
+ * A shape of the game for the expected value of the next refill. The weight
+ * is the number of shapes with the same normalized form.
+ *****************************************************************************/
+
+typedef struct s_solver_piece {
+
+	s_area area;
+
+	int weight;
+
+} s_solver_piece;
+
+/******************************************************************************
+ * The definition of the solver struct. All memory is allocated on creation
+ * and is bound by the beam width.
+ *****************************************************************************/
+
+typedef struct s_solver {
+
+	const s_game_cfg *game_cfg;
+
+	const s_eval_weights *weights;
+
+	//
+	// The maximum number of nodes of a layer.
+	//
+	int beam;
+
+	//
+	// The nodes of the current and the next layer.
+	//
+	s_solver_node *layers[2];
+
+	//
+	// The candidates of the next layer and a hash table with their indices,
+	// which is used to merge equal game areas.
+	//
+	s_solver_child *children;
+
+	int max_children;
+
+	int *table;
+
+	int table_mask;
+
+	//
+	// The random keys for the hashing of the blocks and of the used home
+	// areas.
+	//
+	uint64_t *keys;
+
+	uint64_t used_keys[1 << ENGINE_HOME_MAX];
+
+	//
+	// The scratch data, the normalized home areas and the legal positions.
+	//
+	s_area scratch;
+
+	s_rules rules;
+
+	s_area drop_areas[ENGINE_HOME_MAX];
+
+	s_bitboard anchors;
+
+	//
+	// The distinct shapes for the expected value. If there are no pieces,
+	// the expected value is not computed.
+	//
+	s_solver_piece *pieces;
+
+	int num_pieces;
+
+	int total_weight;
+
+	//
+	// An optional flag, that cancels a running search. In this case the
+	// search returns no move.
+	//
+	atomic_bool *cancel;
+
+} s_solver;
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void solver_create(s_solver *solver, const s_engine *engine, const s_eval_weights *weights, const int beam, const bool expect);
+
+void solver_free(s_solver *solver);
+
+uint64_t solver_hash(const s_solver *solver, const s_area *area, const int used);
+
+bool solver_best_move(s_solver *solver, const s_engine *engine, s_eval_move *move);
+
+#endif /* INC_SOLVER_H_ */
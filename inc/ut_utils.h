@@ -26,6 +26,13 @@
 #define INC_UT_UTILS_H_
 
 #include "common.h"
+#include "s_game_cfg.h"
+
+/******************************************************************************
+ * The seed of the engines of the unit tests.
+ *****************************************************************************/
+
+#define UT_SEED 42
 
 /******************************************************************************
  * The definitions of the functions.
@@ -43,4 +50,8 @@ void ut_check_str(const char *cur, const char *exp, const char *msg);
 
 void ut_check_wstr(const wchar_t *cur, const wchar_t *exp, const char *msg);
 
+int ut_rules_keep(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx);
+
+void ut_game_cfg(s_game_cfg *game_cfg, const s_point *game_dim, const s_point *block, int (*fct_ptr_rules_remove)(s_rules*, s_area*, const s_area*, const s_point*));
+
 #endif /* INC_UT_UTILS_H_ */
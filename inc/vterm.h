@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_VTERM_H_
+#define INC_VTERM_H_
+
+#include "common.h"
+#include "cells.h"
+
+/******************************************************************************
+ * The statistics of a virtual terminal. The attribute changes and the bytes
+ * are counted for the escape sequences, that a real terminal would receive.
+ *****************************************************************************/
+
+typedef struct s_vterm_stats {
+
+	long frames;
+
+	long cells;
+
+	long attr_changes;
+
+	long bytes;
+
+} s_vterm_stats;
+
+/******************************************************************************
+ * The virtual terminal is an in memory screen without a tty. It records the
+ * cells, that were written, and the escape sequences and characters, that a
+ * terminal with 256 colors would receive for them.
+ *****************************************************************************/
+
+typedef struct s_vterm {
+
+	//
+	// The dimension and the content of the screen.
+	//
+	s_point dim;
+
+	s_cell *screen;
+
+	//
+	// The state of the terminal: the position of the cursor and the current
+	// attribute.
+	//
+	s_point cursor;
+
+	attr_t attr;
+
+	//
+	// The bytes of the current frame, which are reset when the frame is
+	// shown.
+	//
+	char *out;
+
+	int out_len;
+
+	int out_size;
+
+	//
+	// The bytes of the last frame, that was shown.
+	//
+	int frame_bytes;
+
+	s_vterm_stats stats;
+
+} s_vterm;
+
+#define vterm_get(v,r,i) (&(v)->screen[(r) * (v)->dim.col + (i)])
+
+/******************************************************************************
+ * Function definitions.
+ *****************************************************************************/
+
+void vterm_create(s_vterm *vterm, const int rows, const int cols);
+
+void vterm_free(s_vterm *vterm);
+
+void vterm_put(s_vterm *vterm, const int row, const int col, const s_cell *cells, const int num);
+
+void vterm_show(s_vterm *vterm);
+
+#endif /* INC_VTERM_H_ */
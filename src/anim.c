@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <time.h>
+#include <errno.h>
+
+#include "anim.h"
+
+/******************************************************************************
+ * The function initializes the animation with the duration of a frame.
+ *****************************************************************************/
+
+void anim_init(s_anim *anim, const long delay) {
+
+	if (delay < 0) {
+		log_exit("Invalid delay: %ld", delay);
+	}
+
+	anim->state = ANIM_IDLE;
+	anim->delay = delay;
+	anim->deadline = 0;
+}
+
+/******************************************************************************
+ * The function returns the current time of the monotonic clock in
+ * milliseconds.
+ *****************************************************************************/
+
+long anim_now() {
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1) {
+		log_exit("Unable to get time: %s", strerror(errno));
+	}
+
+	return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+/******************************************************************************
+ * The function starts a frame of the animation. The frame ends after the
+ * delay.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void anim_start(s_anim *anim, const e_anim_state state, const long now) {
+
+	log_debug("Frame: %d now: %ld", state, now);
+
+	anim->state = state;
+	anim->deadline = now + anim->delay;
+}
+
+/******************************************************************************
+ * The function stops the animation.
+ *****************************************************************************/
+
+void anim_stop(s_anim *anim) {
+
+	anim->state = ANIM_IDLE;
+}
+
+/******************************************************************************
+ * The function checks whether the current frame of a running animation has
+ * reached its deadline.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool anim_is_due(const s_anim *anim, const long now) {
+
+	return anim_is_running(anim) && now >= anim->deadline;
+}
+
+/******************************************************************************
+ * The function returns the time in milliseconds until the deadline of the
+ * current frame, which is the timeout for the input. If no animation is
+ * running, the function returns -1, which means no timeout.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int anim_timeout(const s_anim *anim, const long now) {
+
+	if (!anim_is_running(anim)) {
+		return -1;
+	}
+
+	return now >= anim->deadline ? 0 : (int) (anim->deadline - now);
+}
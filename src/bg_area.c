@@ -25,20 +25,18 @@
 #include <ncurses.h>
 
 #include "common.h"
-#include "colors.h"
+#include "bg_area.h"
 
 /******************************************************************************
  * The background area has only one function, which prints a pixel with a given
  * (drop area) color.
  *****************************************************************************/
 
-void bg_area_print_pixel(WINDOW *win, const s_point *pixel, const t_block da_color) {
+void bg_area_print_pixel(s_cells *cells, const s_point *pixel, const t_block da_color) {
 
 	//
 	// The foreground color is the default (black) and the background color is
 	// the color of the drop area (which might be CLR_NONE).
 	//
-	colors_normal_set_attr(win, da_color);
-
-	mvwprintw(win, pixel->row, pixel->col, "%lc", BLOCK_EMPTY);
+	cells_set(cells, pixel->row, pixel->col, BLOCK_EMPTY, colors_normal_attr(da_color));
 }
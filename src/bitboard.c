@@ -0,0 +1,319 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bitboard.h"
+#include "blocks_simd.h"
+
+/******************************************************************************
+ * The function allocates a bitboard for a given dimension. All rows are stored
+ * in a single allocation. The bitboard is initially empty.
+ *****************************************************************************/
+
+void bitboard_create(s_bitboard *bb, const int rows, const int cols) {
+
+	log_debug("Creating bitboard with: %d/%d", rows, cols);
+
+	bb->row_words = bitboard_num_words(cols);
+
+	s_point_set(&bb->dim, rows, cols);
+
+	bb->words = xmalloc(sizeof(t_word) * bb->row_words * max(rows, 1));
+
+	bitboard_clear(bb);
+}
+
+/******************************************************************************
+ * The function frees the allocated words.
+ *****************************************************************************/
+
+void bitboard_free(s_bitboard *bb) {
+
+	//
+	// Ensure that there is something to free.
+	//
+	if (bb->words == NULL) {
+		log_debug_str("Already freed!");
+		return;
+	}
+
+	free(bb->words);
+
+	//
+	// Set NULL to prevent double frees.
+	//
+	bb->words = NULL;
+}
+
+/******************************************************************************
+ * The function resets all bits of the bitboard.
+ *****************************************************************************/
+
+void bitboard_clear(s_bitboard *bb) {
+	memset(bb->words, 0, sizeof(t_word) * bb->row_words * bb->dim.row);
+}
+
+/******************************************************************************
+ * The function recomputes the bitboard from an array of blocks. Blocks outside
+ * the dimension are treated as empty.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void bitboard_from_blocks(s_bitboard *bb, const s_blocks *blocks, const s_point *dim) {
+
+	bitboard_clear(bb);
+
+	for (int row = 0; row < dim->row; row++) {
+		const t_block *ptr = blocks_row(blocks, row);
+		t_word *word_ptr = bitboard_row(bb, row);
+
+		//
+		// Each word is computed from WORD_BITS blocks with the row kernel.
+		//
+		for (int col = 0; col < dim->col; col += WORD_BITS) {
+			word_ptr[col / WORD_BITS] = blocks_row_mask(&ptr[col], min(WORD_BITS, dim->col - col));
+		}
+	}
+}
+
+/******************************************************************************
+ * The function checks whether a row mask, which is shifted to a given column,
+ * collides with the bits of a row of the bitboard. The mask may span two
+ * words. It is assumed that the shifted mask fits in the row.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool bitboard_row_fits(const s_bitboard *bb, const int row, const int col, const t_word mask) {
+
+	const t_word *ptr = &bitboard_row(bb, row)[col / WORD_BITS];
+
+	const int shift = col % WORD_BITS;
+
+	if (ptr[0] & (mask << shift)) {
+		return false;
+	}
+
+	//
+	// The part of the mask that was shifted out of the first word is
+	// checked against the next word.
+	//
+	if (shift != 0) {
+		const t_word spill = mask >> (WORD_BITS - shift);
+
+		if (spill != 0 && (ptr[1] & spill)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * The function checks whether a shape, which is also a bitboard, can be placed
+ * at a given index of the bitboard without collisions. The rows of the shape
+ * have to fit in one word. It is assumed that the shape is inside the
+ * bitboard.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool bitboard_fits(const s_bitboard *bb, const s_bitboard *shape, const s_point *dim, const s_point *idx) {
+
+	for (int row = 0; row < dim->row; row++) {
+
+		const t_word mask = bitboard_row(shape, row)[0];
+
+		if (mask != 0 && !bitboard_row_fits(bb, idx->row + row, idx->col, mask)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * The function returns a word of a bitboard row, which is shifted to the
+ * right. The bits that are shifted in come from the next word of the row.
+ *****************************************************************************/
+
+static inline t_word row_shift_right(const t_word *ptr, const int row_words, const int word, const int shift) {
+
+	t_word result = ptr[word] >> shift;
+
+	if (shift != 0 && word + 1 < row_words) {
+		result |= ptr[word + 1] << (WORD_BITS - shift);
+	}
+
+	return result;
+}
+
+/******************************************************************************
+ * The function computes all anchors, where a shape can be placed on the
+ * bitboard. An anchor is the index of the upper left corner of the shape. The
+ * anchors are stored as a bitboard, which has to have the same dimension as
+ * the board. The function returns the number of legal anchors.
+ *
+ * An anchor column c is blocked, if there is a shape bit b, where the board
+ * bit c + b is set. So the blocked anchors of a row are the OR of the board
+ * rows, shifted right by each bit of the shape mask. This computes a whole
+ * word of anchors in one pass.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int bitboard_anchors(const s_bitboard *bb, const s_point *dim, const s_bitboard *shape, const s_point *shape_dim, s_bitboard *anchors) {
+
+	bitboard_clear(anchors);
+
+	//
+	// Compute the end index to ensure that the shape fits in the board.
+	//
+	const int row_end = dim->row - shape_dim->row;
+	const int col_end = dim->col - shape_dim->col;
+
+	if (row_end < 0 || col_end < 0) {
+		return 0;
+	}
+
+	//
+	// The number of words with anchors and the mask for the valid anchor
+	// columns of the last word.
+	//
+	const int words = bitboard_num_words(col_end + 1);
+
+	const int rest = (col_end + 1) % WORD_BITS;
+	const t_word last = rest == 0 ? ~(t_word) 0 : bitboard_bit(rest) - 1;
+
+	int num = 0;
+
+	for (int row = 0; row <= row_end; row++) {
+		t_word *anchor_ptr = bitboard_row(anchors, row);
+
+		for (int word = 0; word < words; word++) {
+			t_word blocked = 0;
+
+			for (int shape_row = 0; shape_row < shape_dim->row; shape_row++) {
+				const t_word *ptr = bitboard_row(bb, row + shape_row);
+
+				//
+				// Iterate over the set bits of the shape mask.
+				//
+				for (t_word mask = bitboard_row(shape, shape_row)[0]; mask != 0; mask &= mask - 1) {
+					blocked |= row_shift_right(ptr, bb->row_words, word, __builtin_ctzll(mask));
+				}
+			}
+
+			t_word legal = ~blocked;
+
+			if (word == words - 1) {
+				legal &= last;
+			}
+
+			anchor_ptr[word] = legal;
+
+			num += __builtin_popcountll(legal);
+		}
+	}
+
+	log_debug("Legal anchors: %d", num);
+
+	return num;
+}
+
+/******************************************************************************
+ * The function searches the first set bit of a bitboard in row major order.
+ * If a bit is found, its index is stored in the point.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool bitboard_first(const s_bitboard *bb, s_point *idx) {
+
+	for (int row = 0; row < bb->dim.row; row++) {
+		const t_word *ptr = bitboard_row(bb, row);
+
+		for (int word = 0; word < bb->row_words; word++) {
+
+			if (ptr[word] != 0) {
+				s_point_set(idx, row, word * WORD_BITS + __builtin_ctzll(ptr[word]));
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/******************************************************************************
+ * The function normalizes a bitboard in place, by moving the bounding box of
+ * the set bits to the upper left corner. The dimension of the bounding box is
+ * stored in the norm_dim parameter. It is 0/0 if no bit is set. The rows of
+ * the bitboard have to fit in one word.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void bitboard_normalize(s_bitboard *bb, const s_point *dim, s_point *norm_dim) {
+	int row_start = -1;
+	int row_end = -1;
+	t_word cols = 0;
+
+	//
+	// Compute the rows of the bounding box and the union of all rows.
+	//
+	for (int row = 0; row < dim->row; row++) {
+		const t_word word = bitboard_row(bb, row)[0];
+
+		if (word != 0) {
+
+			if (row_start < 0) {
+				row_start = row;
+			}
+
+			row_end = row;
+			cols |= word;
+		}
+	}
+
+	if (cols == 0) {
+		s_point_set(norm_dim, 0, 0);
+		return;
+	}
+
+	const int col_start = __builtin_ctzll(cols);
+	const int col_end = WORD_BITS - 1 - __builtin_clzll(cols);
+
+	s_point_set(norm_dim, row_end - row_start + 1, col_end - col_start + 1);
+
+	//
+	// Move the rows up and to the left. The source row is always behind the
+	// target row, so no bits are overwritten before they are moved.
+	//
+	for (int row = 0; row < dim->row; row++) {
+		bitboard_row(bb, row)[0] = row < norm_dim->row ? bitboard_row(bb, row + row_start)[0] >> col_start : 0;
+	}
+
+	log_debug("Normalized from: %d/%d dim: %d/%d", row_start, col_start, norm_dim->row, norm_dim->col);
+}
@@ -23,74 +23,75 @@
  */
 
 #include "blocks.h"
-#include "colors.h"
+#include "blocks_simd.h"
 
 /******************************************************************************
- * The function creates a 2-dimensional array of blocks.
+ * The function creates a 2-dimensional array of blocks. All rows are stored in
+ * a single allocation. The number of columns is rounded up, so that each row
+ * starts at an address, that is aligned to BLOCKS_ALIGN.
  *****************************************************************************/
 
-t_block** blocks_create(const int rows, const int cols) {
+void blocks_create(s_blocks *blocks, const int rows, const int cols) {
 
 	log_debug("Creating block with: %d/%d", rows, cols);
 
-	t_block **blocks = xmalloc(sizeof(t_block*) * rows);
+	const int per_align = BLOCKS_ALIGN / sizeof(t_block);
 
-	for (int row = 0; row < rows; row++) {
-		blocks[row] = xmalloc(sizeof(t_block) * cols);
-	}
+	blocks->stride = ((cols + per_align - 1) / per_align) * per_align;
+
+	s_point_set(&blocks->dim, rows, cols);
 
-	return blocks;
+	blocks->data = xmalloc_aligned(BLOCKS_ALIGN, sizeof(t_block) * blocks->stride * rows);
 }
 
 /******************************************************************************
  * The function frees the allocated data.
  *****************************************************************************/
 
-void blocks_free(t_block **blocks, const int rows) {
+void blocks_free(s_blocks *blocks) {
 
 	//
 	// Ensure that there is something to free.
 	//
-	if (blocks == NULL) {
+	if (blocks->data == NULL) {
 		log_debug_str("Already freed!");
 		return;
 	}
 
-	for (int row = 0; row < rows; row++) {
-		free(blocks[row]);
-	}
-
-	free(blocks);
+	free(blocks->data);
 
 	//
 	// Set NULL to prevent double frees.
 	//
-	blocks = NULL;
+	blocks->data = NULL;
 }
 
 /******************************************************************************
  * The function initializes / sets a 2-dimensional array of blocks with a given
- * value.
+ * value. If the dimension covers complete rows, the padding is set too and the
+ * data is processed as one linear array.
  *****************************************************************************/
 
-void blocks_set(t_block **blocks, const s_point *dim, const t_block value) {
+void blocks_set(s_blocks *blocks, const s_point *dim, const t_block value) {
+
+	if (dim->col == blocks->dim.col) {
+		blocks_row_fill(blocks->data, value, dim->row * blocks->stride);
+		return;
+	}
 
 	for (int row = 0; row < dim->row; row++) {
-		for (int col = 0; col < dim->col; col++) {
-			blocks[row][col] = value;
-		}
+		blocks_row_fill(blocks_row(blocks, row), value, dim->col);
 	}
 }
 
 /******************************************************************************
- * The function copies from block array to an other.
+ * The function copies from block array to an other. The rows are copied with
+ * memcpy, because both arrays are contiguous.
  *****************************************************************************/
 
-void blocks_copy(t_block **from, t_block **to, const s_point *dim) {
+void blocks_copy(const s_blocks *from, s_blocks *to, const s_point *dim) {
 
 	for (int row = 0; row < dim->row; row++) {
-		for (int col = 0; col < dim->col; col++) {
-			to[row][col] = from[row][col];
-		}
+		memcpy(blocks_row(to, row), blocks_row(from, row), sizeof(t_block) * dim->col);
 	}
 }
@@ -0,0 +1,337 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "blocks_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#define BLOCKS_SIMD_X86
+
+#endif
+
+/******************************************************************************
+ * The struct contains the kernels for one instruction set.
+ *****************************************************************************/
+
+typedef struct s_blocks_ops {
+
+	const char *name;
+
+	void (*fill)(t_block *row, const t_block value, const int num);
+
+	uint64_t (*mask)(const t_block *row, const int num);
+
+} s_blocks_ops;
+
+// ----------------------------------------
+// SCALAR
+
+/******************************************************************************
+ * The scalar kernels are the fallback and process the tails of the vector
+ * kernels. The functions have a start index for this purpose.
+ *****************************************************************************/
+
+static inline void scalar_fill(t_block *row, const t_block value, const int start, const int num) {
+
+	for (int i = start; i < num; i++) {
+		row[i] = value;
+	}
+}
+
+static inline uint64_t scalar_mask(const t_block *row, const int start, const int num) {
+	uint64_t mask = 0;
+
+	for (int i = start; i < num; i++) {
+		if (row[i] != CLR_NONE) {
+			mask |= (uint64_t) 1 << i;
+		}
+	}
+
+	return mask;
+}
+
+static void scalar_fill_row(t_block *row, const t_block value, const int num) {
+	scalar_fill(row, value, 0, num);
+}
+
+static uint64_t scalar_mask_row(const t_block *row, const int num) {
+	return scalar_mask(row, 0, num);
+}
+
+static const s_blocks_ops _ops_scalar = {
+
+	.name = "scalar",
+
+	.fill = scalar_fill_row,
+
+	.mask = scalar_mask_row
+};
+
+#ifdef BLOCKS_SIMD_X86
+
+// ----------------------------------------
+// SSE2
+
+/******************************************************************************
+ * The SSE2 kernels process 8 blocks per iteration. The comparison results are
+ * 16 bit lanes, so they are packed to 8 bit lanes before _mm_movemask_epi8()
+ * is called, to get one bit per block.
+ *****************************************************************************/
+
+#define SSE2_NUM 8
+
+__attribute__((target("sse2")))
+static void sse2_fill(t_block *row, const t_block value, const int num) {
+	const __m128i vec = _mm_set1_epi16(value);
+	int i = 0;
+
+	for (; i + SSE2_NUM <= num; i += SSE2_NUM) {
+		_mm_storeu_si128((__m128i*) &row[i], vec);
+	}
+
+	scalar_fill(row, value, i, num);
+}
+
+/******************************************************************************
+ * The function returns a bit mask with the empty blocks of 8 blocks.
+ *****************************************************************************/
+
+__attribute__((target("sse2")))
+static inline unsigned int sse2_empty_bits(const t_block *ptr) {
+
+	const __m128i empty = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*) ptr), _mm_set1_epi16(CLR_NONE));
+
+	return _mm_movemask_epi8(_mm_packs_epi16(empty, _mm_setzero_si128())) & 0xff;
+}
+
+__attribute__((target("sse2")))
+static uint64_t sse2_mask(const t_block *row, const int num) {
+	uint64_t mask = 0;
+	int i = 0;
+
+	for (; i + SSE2_NUM <= num; i += SSE2_NUM) {
+		mask |= (uint64_t) (~sse2_empty_bits(&row[i]) & 0xff) << i;
+	}
+
+	return mask | scalar_mask(row, i, num);
+}
+
+static const s_blocks_ops _ops_sse2 = {
+
+	.name = "sse2",
+
+	.fill = sse2_fill,
+
+	.mask = sse2_mask
+};
+
+// ----------------------------------------
+// AVX2
+
+/******************************************************************************
+ * The AVX2 kernels process 16 blocks per iteration. _mm256_packs_epi16() packs
+ * within the 128 bit lanes, so the result has to be permuted to get the bits
+ * in the order of the blocks.
+ *****************************************************************************/
+
+#define AVX2_NUM 16
+
+__attribute__((target("avx2")))
+static void avx2_fill(t_block *row, const t_block value, const int num) {
+	const __m256i vec = _mm256_set1_epi16(value);
+	int i = 0;
+
+	for (; i + AVX2_NUM <= num; i += AVX2_NUM) {
+		_mm256_storeu_si256((__m256i*) &row[i], vec);
+	}
+
+	scalar_fill(row, value, i, num);
+}
+
+/******************************************************************************
+ * The function returns a bit mask with the empty blocks of 16 blocks.
+ *****************************************************************************/
+
+__attribute__((target("avx2")))
+static inline unsigned int avx2_empty_bits(const t_block *ptr) {
+
+	const __m256i empty = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*) ptr), _mm256_set1_epi16(CLR_NONE));
+
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(empty, _mm256_setzero_si256()), 0xd8);
+
+	return _mm256_movemask_epi8(packed) & 0xffff;
+}
+
+__attribute__((target("avx2")))
+static uint64_t avx2_mask(const t_block *row, const int num) {
+	uint64_t mask = 0;
+	int i = 0;
+
+	for (; i + AVX2_NUM <= num; i += AVX2_NUM) {
+		mask |= (uint64_t) (~avx2_empty_bits(&row[i]) & 0xffff) << i;
+	}
+
+	return mask | scalar_mask(row, i, num);
+}
+
+static const s_blocks_ops _ops_avx2 = {
+
+	.name = "avx2",
+
+	.fill = avx2_fill,
+
+	.mask = avx2_mask
+};
+
+#endif
+
+// ----------------------------------------
+// DISPATCH
+
+/******************************************************************************
+ * The kernels, that are used. They are selected once on the first call. The
+ * kernels are used by the worker threads of the simulation and the hint, so
+ * the selection is done with pthread_once(). After the selection, the atomic
+ * pointer is read without the call.
+ *****************************************************************************/
+
+static _Atomic(const s_blocks_ops*) _ops = NULL;
+
+static pthread_once_t _ops_once = PTHREAD_ONCE_INIT;
+
+/******************************************************************************
+ * The function selects the best kernels, that are supported by the cpu.
+ *****************************************************************************/
+
+static void blocks_simd_select() {
+
+#ifdef BLOCKS_SIMD_X86
+
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2")) {
+		atomic_store_explicit(&_ops, &_ops_avx2, memory_order_release);
+
+	} else if (__builtin_cpu_supports("sse2")) {
+		atomic_store_explicit(&_ops, &_ops_sse2, memory_order_release);
+
+	} else {
+		atomic_store_explicit(&_ops, &_ops_scalar, memory_order_release);
+	}
+
+#else
+
+	atomic_store_explicit(&_ops, &_ops_scalar, memory_order_release);
+
+#endif
+
+	log_debug("Using kernels: %s", atomic_load(&_ops)->name);
+}
+
+static inline const s_blocks_ops* blocks_ops() {
+	const s_blocks_ops *ops = atomic_load_explicit(&_ops, memory_order_acquire);
+
+	if (ops != NULL) {
+		return ops;
+	}
+
+	pthread_once(&_ops_once, blocks_simd_select);
+
+	return atomic_load_explicit(&_ops, memory_order_acquire);
+}
+
+// ----------------------------------------
+// INTERFACE
+
+/******************************************************************************
+ * The function sets the blocks of a row to a value.
+ *****************************************************************************/
+
+void blocks_row_fill(t_block *row, const t_block value, const int num) {
+	blocks_ops()->fill(row, value, num);
+}
+
+/******************************************************************************
+ * The function returns a bit mask with the blocks of a row, which are set
+ * (not CLR_NONE). Bit i corresponds to block i, so the row can have at most
+ * 64 blocks.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+uint64_t blocks_row_mask(const t_block *row, const int num) {
+	return blocks_ops()->mask(row, num);
+}
+
+/******************************************************************************
+ * The function returns the name of the kernels, that are used.
+ *****************************************************************************/
+
+const char* blocks_simd_name() {
+	return blocks_ops()->name;
+}
+
+/******************************************************************************
+ * The function selects the kernels with a given name. This is used by the
+ * unit tests to check all kernels. The function returns false if the kernels
+ * are not supported by the cpu. It must not be called while other threads use
+ * the kernels.
+ *****************************************************************************/
+
+bool blocks_simd_use(const char *name) {
+
+	//
+	// Ensure that the selection does not overwrite the kernels later.
+	//
+	pthread_once(&_ops_once, blocks_simd_select);
+
+	if (strcmp(name, _ops_scalar.name) == 0) {
+		atomic_store(&_ops, &_ops_scalar);
+		return true;
+	}
+
+#ifdef BLOCKS_SIMD_X86
+
+	__builtin_cpu_init();
+
+	if (strcmp(name, _ops_sse2.name) == 0 && __builtin_cpu_supports("sse2")) {
+		atomic_store(&_ops, &_ops_sse2);
+		return true;
+	}
+
+	if (strcmp(name, _ops_avx2.name) == 0 && __builtin_cpu_supports("avx2")) {
+		atomic_store(&_ops, &_ops_avx2);
+		return true;
+	}
+
+#endif
+
+	return false;
+}
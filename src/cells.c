@@ -0,0 +1,210 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cells.h"
+
+/******************************************************************************
+ * A character, that is never written. A previous frame with this character
+ * differs from each cell, so the cell is flushed.
+ *****************************************************************************/
+
+#define CHR_INVALID ((wchar_t) -1)
+
+/******************************************************************************
+ * The function allocates the frames of the buffer with the given dimension.
+ * The current frame is cleared and the previous frame is invalid.
+ *****************************************************************************/
+
+static void cells_alloc(s_cells *cells, const int rows, const int cols) {
+
+	cells->dim.row = rows;
+	cells->dim.col = cols;
+
+	const size_t num = (size_t) rows * cols;
+
+	//
+	// A window may have a size of 0, so we allocate at least one cell.
+	//
+	cells->cur = xmalloc(sizeof(s_cell) * (num > 0 ? num : 1));
+	cells->prev = xmalloc(sizeof(s_cell) * (num > 0 ? num : 1));
+
+	cells_clear(cells);
+
+	cells_invalidate(cells);
+}
+
+/******************************************************************************
+ * The function creates the cell buffer for a window with the given size. The
+ * attribute is used for empty cells, which is the background of the window.
+ *****************************************************************************/
+
+void cells_create(s_cells *cells, const int rows, const int cols, const attr_t bg) {
+
+	log_debug("Create cells: %d/%d", rows, cols);
+
+	cells->bg = bg;
+
+	cells_alloc(cells, rows, cols);
+}
+
+/******************************************************************************
+ * The function frees the cell buffer.
+ *****************************************************************************/
+
+void cells_free(s_cells *cells) {
+
+	free(cells->cur);
+	cells->cur = NULL;
+
+	free(cells->prev);
+	cells->prev = NULL;
+}
+
+/******************************************************************************
+ * The function resizes the cell buffer, if the window size changed. In this
+ * case the buffer is cleared.
+ *****************************************************************************/
+
+void cells_resize(s_cells *cells, const int rows, const int cols) {
+
+	if (cells->dim.row == rows && cells->dim.col == cols) {
+		return;
+	}
+
+	log_debug("Resize cells: %d/%d -> %d/%d", cells->dim.row, cells->dim.col, rows, cols);
+
+	cells_free(cells);
+
+	cells_alloc(cells, rows, cols);
+}
+
+/******************************************************************************
+ * The function sets all cells of the current frame to empty cells.
+ *****************************************************************************/
+
+void cells_clear(s_cells *cells) {
+	const int num = cells->dim.row * cells->dim.col;
+
+	for (int i = 0; i < num; i++) {
+		cells->cur[i].chr = L' ';
+		cells->cur[i].attr = cells->bg;
+	}
+}
+
+/******************************************************************************
+ * The function invalidates the previous frame, so the next flush writes all
+ * cells. This is necessary if the content of the window is unknown, for
+ * example after a menu was shown.
+ *****************************************************************************/
+
+void cells_invalidate(s_cells *cells) {
+	const int num = cells->dim.row * cells->dim.col;
+
+	for (int i = 0; i < num; i++) {
+		cells->prev[i].chr = CHR_INVALID;
+		cells->prev[i].attr = 0;
+	}
+}
+
+/******************************************************************************
+ * The function copies the current frame of a buffer with the same dimension,
+ * which is used as a layer.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void cells_copy(s_cells *to, const s_cells *from) {
+
+	if (!s_point_same(&to->dim, &from->dim)) {
+		log_exit("Dimensions differ: %d/%d - %d/%d", to->dim.row, to->dim.col, from->dim.row, from->dim.col);
+	}
+
+	memcpy(to->cur, from->cur, sizeof(s_cell) * to->dim.row * to->dim.col);
+}
+
+/******************************************************************************
+ * The function sets a cell of the current frame. Cells outside the buffer are
+ * ignored, like characters outside a window.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void cells_set(s_cells *cells, const int row, const int col, const wchar_t chr, const attr_t attr) {
+
+	if (!cells_is_inside(cells, row, col)) {
+		log_debug("Outside: %d/%d", row, col);
+		return;
+	}
+
+	s_cell *cell = cells_get(cells, row, col);
+
+	cell->chr = chr;
+	cell->attr = attr;
+}
+
+/******************************************************************************
+ * The function sets the cells of a row with the characters of a string.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void cells_set_str(s_cells *cells, const int row, const int col, const wchar_t *str, const attr_t attr) {
+
+	for (int i = 0; str[i] != L'\0'; i++) {
+		cells_set(cells, row, col + i, str[i], attr);
+	}
+}
+
+/******************************************************************************
+ * The function searches the next run of changed cells of a row, starting at
+ * the start column. If a run is found, start is set to its first and end to
+ * the column after its last cell.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool cells_next_run(const s_cells *cells, const int row, int *start, int *end) {
+	const s_cell *cur = cells_get(cells, row, 0);
+	const s_cell *prev = cells_get_prev(cells, row, 0);
+
+	int col = *start;
+
+	while (col < cells->dim.col && cur[col].chr == prev[col].chr && cur[col].attr == prev[col].attr) {
+		col++;
+	}
+
+	if (col == cells->dim.col) {
+		return false;
+	}
+
+	*start = col;
+
+	while (col < cells->dim.col && (cur[col].chr != prev[col].chr || cur[col].attr != prev[col].attr)) {
+		col++;
+	}
+
+	*end = col;
+
+	return true;
+}
@@ -137,6 +137,31 @@ static const char *_color_def_names[COL_DEF_NUM] = {
 
 static t_block _color_pairs[NUM_COLORS][NUM_COLORS];
 
+/******************************************************************************
+ * The terminal colors of the color pairs, indexed by the color pair. The
+ * virtual terminal uses them for its escape sequences. With virtual colors,
+ * the color pairs are only recorded and not initialized with ncurses.
+ *****************************************************************************/
+
+#define CP_MAX 64
+
+static short _pair_content[CP_MAX][2];
+
+static bool _virtual = false;
+
+/******************************************************************************
+ * The cells of the chess pattern areas are precomputed for each chess type,
+ * chess class and pair of game area and drop area colors. Both colors are
+ * normal colors or CLR_NONE. The light colors of the double chess pattern are
+ * resolved by the chess class.
+ *****************************************************************************/
+
+#define CHESS_TYPE_NUM (CHESS_DOUBLE + 1)
+
+#define NUM_NORMAL (CLR_YELL_N + 1)
+
+static s_cell _chess_cells[CHESS_TYPE_NUM][CHESS_CLASS_NUM][NUM_NORMAL][NUM_NORMAL];
+
 /******************************************************************************
  * The function initializes the array with the color pairs. They are set to an
  * undefined value. Not all combinations of color pairs are necessary.
@@ -149,6 +174,11 @@ static void color_pairs_undef() {
 			_color_pairs[fg][bg] = CP_UNDEF;
 		}
 	}
+
+	for (int pair = 0; pair < CP_MAX; pair++) {
+		_pair_content[pair][0] = CP_UNDEF;
+		_pair_content[pair][1] = CP_UNDEF;
+	}
 }
 
 /******************************************************************************
@@ -191,10 +221,17 @@ static inline t_block color_pair_get(const short fg, const short bg) {
 
 static short colors_init_pair(const short pair, const short fg, const short bg) {
 
-	if (init_pair(pair, fg, bg) != OK) {
+	if (pair >= CP_MAX) {
+		log_exit("Color pair too large: %d", pair);
+	}
+
+	if (!_virtual && init_pair(pair, fg, bg) != OK) {
 		log_exit("Unable to init color pair: %d fg: %d bg: %d", pair, fg, bg);
 	}
 
+	_pair_content[pair][0] = fg;
+	_pair_content[pair][1] = bg;
+
 	return pair;
 }
 
@@ -476,95 +513,40 @@ static void color_pairs_alloc() {
 }
 
 /******************************************************************************
- * The function initializes the colors and color pairs. It ensures that the
- * terminal supports colors.
+ * The function returns the background chess pattern color for a chess class.
+ * The double chess pattern toggles the colors of the squares with the given
+ * dimension.
  *****************************************************************************/
 
-void colors_init() {
-
-	//
-	// Ensure that the terminal is ok.
-	//
-	if (!has_colors()) {
-		log_exit_str("Terminal does not support colors!");
-	}
-
-	if (!can_change_color()) {
-		log_exit_str("Terminal does not support color changes!");
-	}
-
-	//
-	// Start the color.
-	//
-	if (start_color() != OK) {
-		log_exit_str("Unable to init colors!");
-	}
+static short colors_chess_get_color(const int chess_class, const e_chess_type chess_type) {
 
-	//
-	// Allocate the necessary colors.
-	//
-	colors_alloc();
-
-	//
-	// Initialize the color pairs with an undefined value.
-	//
-	color_pairs_undef();
-
-	//
-	// Allocate the necessary color pairs.
-	//
-	color_pairs_alloc();
-}
-
-/******************************************************************************
- * The function sets the color for the normal areas (no chess pattern). It is
- * called with the color of the drop area, which is the background color. The
- * foreground color is CLR_NONE, which means the default color.
- *****************************************************************************/
-
-void colors_normal_set_attr(WINDOW *win, const t_block da_color) {
-	wattrset(win, COLOR_PAIR(color_pair_get(CLR_NONE, da_color)));
-}
-
-/******************************************************************************
- * The function sets the color for the info area if the current game ended.
- *****************************************************************************/
-
-void colors_normal_end_attr(WINDOW *win) {
-	wattrset(win, A_BLINK| COLOR_PAIR(color_pair_get(CLR_RED__N,CLR_NONE)));
-}
-
-/******************************************************************************
- * The function returns the background chess pattern color for a given index.
- *****************************************************************************/
-
-static short colors_chess_get_color(const s_point *idx, const e_chess_type chess_type) {
+	const bool even_block = chess_class & CHESS_CLASS_EVEN_BLOCK;
 
 	//
 	// Simple chess pattern with 2 dark colors
 	//
 	if (chess_type == CHESS_SIMPLE_DARK) {
-		return colors_is_even(idx->row, idx->col) ? CLR_GREY_MID__ : CLR_GREY_DARK_;
+		return even_block ? CLR_GREY_MID__ : CLR_GREY_DARK_;
 	}
 
 	//
 	// Simple chess pattern with 2 light colors
 	//
 	if (chess_type == CHESS_SIMPLE_LIGHT) {
-		return colors_is_even(idx->row, idx->col) ? CLR_GREY_LIGHT : CLR_GREY_MID__;
+		return even_block ? CLR_GREY_LIGHT : CLR_GREY_MID__;
 	}
 
 	//
 	// Double chess pattern. The even blocks have the middle color.
 	//
-	if (colors_is_even(idx->row, idx->col)) {
+	if (even_block) {
 		return CLR_GREY_MID__;
 	}
 
 	//
 	// Toggle the odd blocks.
 	//
-	if (colors_is_even((idx->row / 3), (idx->col / 3))) {
+	if (chess_class & CHESS_CLASS_EVEN_SQUARE) {
 		return CLR_GREY_LIGHT;
 	}
 
@@ -572,14 +554,13 @@ static short colors_chess_get_color(const s_point *idx, const e_chess_type chess
 }
 
 /******************************************************************************
- * The function sets the color pair for a chess pattern area and returns the
- * corresponding character. It is called with the game area and the drop area
- * color index and a flag indicating whether the block is odd or even.
+ * The function computes the character and the attribute of a chess pattern
+ * cell. It is called with the game area and the drop area color index and the
+ * chess class of the block.
  *****************************************************************************/
 
-wchar_t colors_chess_attr_char(WINDOW *win, t_block ga_color, const t_block da_color, const s_point *idx, const e_chess_type chess_type) {
+static void colors_chess_cell_init(s_cell *cell, t_block ga_color, const t_block da_color, const int chess_class, const e_chess_type chess_type) {
 	int color_pair;
-	wchar_t chr;
 
 	if (ga_color == CLR_NONE) {
 
@@ -587,8 +568,8 @@ wchar_t colors_chess_attr_char(WINDOW *win, t_block ga_color, const t_block da_c
 		// Both are empty
 		//
 		if (da_color == CLR_NONE) {
-			chr = BLOCK_EMPTY;
-			color_pair = color_pair_get(CLR_NONE, colors_chess_get_color(idx, chess_type));
+			cell->chr = BLOCK_EMPTY;
+			color_pair = _color_pairs[CLR_NONE][colors_chess_get_color(chess_class, chess_type)];
 		}
 
 		//
@@ -596,15 +577,15 @@ wchar_t colors_chess_attr_char(WINDOW *win, t_block ga_color, const t_block da_c
 		// background color.
 		//
 		else {
-			chr = BLOCK_EMPTY;
-			color_pair = color_pair_get(ga_color, da_color);
+			cell->chr = BLOCK_EMPTY;
+			color_pair = _color_pairs[ga_color][da_color];
 		}
 	} else {
 
 		//
 		// If CHESS_DOUBLE is active we assume that ga_color is normal color.
 		//
-		if (chess_type == CHESS_DOUBLE && colors_is_even((idx->row / 3), (idx->col / 3))) {
+		if (chess_type == CHESS_DOUBLE && (chess_class & CHESS_CLASS_EVEN_SQUARE)) {
 
 			//
 			// ATTENTION: Parameter is reset with a light color
@@ -616,24 +597,181 @@ wchar_t colors_chess_attr_char(WINDOW *win, t_block ga_color, const t_block da_c
 		// The foreground is set, so we need a full character.
 		//
 		if (da_color == CLR_NONE) {
-			chr = BLOCK_FULL;
-			color_pair = color_pair_get(ga_color, da_color);
+			cell->chr = BLOCK_FULL;
+			color_pair = _color_pairs[ga_color][da_color];
 		}
 
 		//
 		// Both colors are set, so we need a transparent character.
 		//
 		else {
-			chr = BLOCK_BOTH;
-			color_pair = color_pair_get(ga_color, da_color);
+			cell->chr = BLOCK_BOTH;
+			color_pair = _color_pairs[ga_color][da_color];
 		}
 	}
 
-	log_debug("fg: %d bg: %d pair: %d char '%lc", da_color, ga_color, color_pair, chr);
+	//
+	// Not all combinations of colors have a color pair. An undefined cell is
+	// marked with a terminating character.
+	//
+	if (color_pair == CP_UNDEF) {
+		cell->chr = U_TERM;
+		cell->attr = 0;
+		return;
+	}
+
+	cell->attr = COLOR_PAIR(color_pair);
+}
+
+/******************************************************************************
+ * The function computes the chess cells for all chess types, chess classes
+ * and combinations of normal colors. This requires the color pairs.
+ *****************************************************************************/
+
+static void colors_chess_cells_init() {
+
+	for (int type = 0; type < CHESS_TYPE_NUM; type++) {
+		for (int chess_class = 0; chess_class < CHESS_CLASS_NUM; chess_class++) {
+			for (t_block ga_color = 0; ga_color < NUM_NORMAL; ga_color++) {
+				for (t_block da_color = 0; da_color < NUM_NORMAL; da_color++) {
+					colors_chess_cell_init(&_chess_cells[type][chess_class][ga_color][da_color], ga_color, da_color, chess_class, type);
+				}
+			}
+		}
+	}
+}
+
+/******************************************************************************
+ * The function initializes the colors and color pairs. It ensures that the
+ * terminal supports colors.
+ *****************************************************************************/
+
+void colors_init() {
+
+	//
+	// Ensure that the terminal is ok.
+	//
+	if (!has_colors()) {
+		log_exit_str("Terminal does not support colors!");
+	}
+
+	if (!can_change_color()) {
+		log_exit_str("Terminal does not support color changes!");
+	}
+
+	//
+	// Start the color.
+	//
+	if (start_color() != OK) {
+		log_exit_str("Unable to init colors!");
+	}
+
+	//
+	// Allocate the necessary colors.
+	//
+	colors_alloc();
+
+	//
+	// Initialize the color pairs with an undefined value.
+	//
+	color_pairs_undef();
+
+	//
+	// Allocate the necessary color pairs.
+	//
+	color_pairs_alloc();
+
+	//
+	// Precompute the chess cells, which requires the color pairs.
+	//
+	colors_chess_cells_init();
+}
 
-	wattrset(win, COLOR_PAIR(color_pair));
+/******************************************************************************
+ * The function initializes the color pairs without a terminal. This is used
+ * by the virtual terminal. The colors are not allocated, so the color pairs
+ * refer to the terminal colors, without the definitions of the color config.
+ *****************************************************************************/
+
+void colors_init_virtual() {
+
+	_virtual = true;
+
+	color_pairs_undef();
+
+	color_pairs_alloc();
+
+	colors_chess_cells_init();
+}
+
+/******************************************************************************
+ * The function returns the terminal colors of a color pair. It returns false
+ * if the color pair is not defined or is the default color pair.
+ *****************************************************************************/
+
+bool colors_pair_content(const short pair, short *fg, short *bg) {
+
+	if (pair < CP_START || pair >= CP_MAX || _pair_content[pair][0] == CP_UNDEF) {
+		return false;
+	}
+
+	*fg = _pair_content[pair][0];
+	*bg = _pair_content[pair][1];
+
+	return true;
+}
+
+/******************************************************************************
+ * The function returns the attribute for the normal areas (no chess pattern).
+ * It is called with the color of the drop area, which is the background
+ * color. The foreground color is CLR_NONE, which means the default color.
+ *****************************************************************************/
+
+attr_t colors_normal_attr(const t_block da_color) {
+	return COLOR_PAIR(color_pair_get(CLR_NONE, da_color));
+}
+
+/******************************************************************************
+ * The function returns the attribute for the info area if the current game
+ * ended.
+ *****************************************************************************/
+
+attr_t colors_end_attr() {
+	return A_BLINK | COLOR_PAIR(color_pair_get(CLR_RED__N, CLR_NONE));
+}
+
+/******************************************************************************
+ * The function returns the precomputed cell (character and attribute) for a
+ * chess pattern area. It is called with the game area and the drop area color
+ * index and the index of the block. The square dimension is only used by the
+ * double chess pattern.
+ *****************************************************************************/
+
+const s_cell* colors_chess_cell(const t_block ga_color, const t_block da_color, const s_point *idx, const e_chess_type chess_type, const int square_dim) {
+
+#ifdef DEBUG
+
+	//
+	// Ensure that the colors are normal colors.
+	//
+	if (ga_color < 0 || ga_color >= NUM_NORMAL || da_color < 0 || da_color >= NUM_NORMAL) {
+		log_exit("Invalid color - ga: %d da: %d", ga_color, da_color);
+	}
+#endif
+
+	const s_cell *cell = &_chess_cells[chess_type][colors_chess_class(idx, square_dim)][ga_color][da_color];
+
+#ifdef DEBUG
+
+	//
+	// Ensure that the color pair is defined.
+	//
+	if (cell->chr == U_TERM) {
+		log_exit("Color pair is not defined - ga: %d da: %d", ga_color, da_color);
+	}
+#endif
 
-	return chr;
+	return cell;
 }
 
 /******************************************************************************
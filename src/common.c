@@ -28,6 +28,7 @@
 #include <errno.h>
 #include <wchar.h>
 #include <stdarg.h>
+#include <time.h>
 
 /******************************************************************************
  * Register exit callback function.
@@ -81,6 +82,25 @@ void* xmalloc(const size_t size) {
 	return ptr;
 }
 
+/******************************************************************************
+ * The function allocates memory with a given alignment and terminates the
+ * program in case of an error. The size is rounded up to a multiple of the
+ * alignment, which is required by aligned_alloc().
+ *****************************************************************************/
+
+void* xmalloc_aligned(const size_t align, const size_t size) {
+
+	const size_t aligned_size = ((size + align - 1) / align) * align;
+
+	void *ptr = aligned_alloc(align, aligned_size > 0 ? aligned_size : align);
+
+	if (ptr == NULL) {
+		log_exit("Unable to allocate: %zu bytes of memory with alignment: %zu!", aligned_size, align);
+	}
+
+	return ptr;
+}
+
 /******************************************************************************
  * The function is called with an array of strings, which is NULL terminated.
  * It computes the maximal string length and the number of rows.
@@ -350,3 +370,18 @@ void fmt_center(wchar_t *dst, const int size, const wchar_t pad, const wchar_t *
 	//
 	dst[size - 1] = U_TERM;
 }
+
+/******************************************************************************
+ * The function returns the current time in seconds. The clock is monotonic,
+ * so it is used to measure durations.
+ *****************************************************************************/
+
+double get_time() {
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1) {
+		log_exit_str("Unable to get the time!");
+	}
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
@@ -0,0 +1,379 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "engine.h"
+#include "rules.h"
+
+/******************************************************************************
+ * The function creates and initializes all data structures for a new game of
+ * a given type. The s_game_cfg struct contains the definition of the selected
+ * game. The seed initializes the random number generator of the game.
+ *****************************************************************************/
+
+void engine_create(s_engine *engine, const s_game_cfg *game_cfg, const uint32_t seed) {
+
+	log_debug("Create engine: %s", game_cfg->title);
+
+	//
+	// Ensure that the number of home areas is valid.
+	//
+	if (game_cfg->home_num > ENGINE_HOME_MAX) {
+		log_exit("Number of home areas too large: %d", game_cfg->home_num);
+	}
+
+	engine->game_cfg = game_cfg;
+
+	//
+	// Create the game area.
+	//
+	s_area_create(&engine->game_area, &game_cfg->game_dim, &game_cfg->game_size);
+
+	s_area_set_blocks(&engine->game_area, CLR_NONE);
+
+	//
+	// The squares are used by the squares-lines rules and the double chess
+	// pattern.
+	//
+	if (game_cfg->type == TYPE_SQUARES_LINES) {
+		s_area_create_squares(&engine->game_area, game_cfg->square_dim);
+	}
+
+	//
+	// Create the drop area and the bitboard for the legal positions. The drop
+	// area is printed on the game area, so it has the size of the game area
+	// blocks.
+	//
+	s_area_create(&engine->drop_area, &game_cfg->drop_dim, &game_cfg->game_size);
+
+	bitboard_create(&engine->anchors, game_cfg->game_dim.row, game_cfg->game_dim.col);
+
+	//
+	// Create the home areas.
+	//
+	engine->home_num = game_cfg->home_num;
+
+	for (int i = 0; i < engine->home_num; i++) {
+		log_debug("Creating home area: %d", i);
+
+		s_area_create(&engine->home[i].area, &game_cfg->drop_dim, &game_cfg->home_size);
+
+		bitboard_create(&engine->home[i].norm, game_cfg->drop_dim.row, game_cfg->drop_dim.col);
+	}
+
+	//
+	// Allocate the backup storage for the picked up home area.
+	//
+	s_area_create(&engine->backup, &game_cfg->drop_dim, &game_cfg->home_size);
+
+	//
+	// Create and initialize the rules for the game.
+	//
+	rules_create_game(&engine->rules, &engine->game_area);
+
+	//
+	// Set / load game data
+	//
+	engine->game_data.shapes = NULL;
+
+	game_cfg->fct_ptr_set_data(&engine->game_data, game_cfg->data);
+
+	engine_reset(engine, seed);
+}
+
+/******************************************************************************
+ * The function frees the memory of the engine. It is possible that the engine
+ * was not created.
+ *****************************************************************************/
+
+void engine_free(s_engine *engine) {
+
+	log_debug("Freeing game area: %d/%d", engine->game_area.dim.row, engine->game_area.dim.col);
+
+	s_area_free(&engine->game_area);
+
+	rules_free_game(&engine->rules);
+
+	//
+	// The blocks know their allocated dimension, so the normalization of the
+	// drop area, which changes the dimension, does not matter.
+	//
+	s_area_free(&engine->drop_area);
+
+	s_area_free(&engine->backup);
+
+	bitboard_free(&engine->anchors);
+
+	//
+	// The shapes are allocated by the set data function of the shapes games.
+	//
+	free(engine->game_data.shapes);
+	engine->game_data.shapes = NULL;
+
+	for (int i = 0; i < engine->home_num; i++) {
+		s_area_free(&engine->home[i].area);
+
+		bitboard_free(&engine->home[i].norm);
+	}
+}
+
+/******************************************************************************
+ * The function resets the engine to start a new game with a given seed. The
+ * game area is cleared and the home areas are refilled. A game is completely
+ * defined by its seed and the moves.
+ *****************************************************************************/
+
+void engine_reset(s_engine *engine, const uint32_t seed) {
+
+	engine->seed = seed;
+
+	rng_seed(&engine->rng, seed);
+
+	s_area_set_blocks(&engine->game_area, CLR_NONE);
+
+	engine->score = 0;
+
+	engine->turns = 0;
+
+	engine->end = false;
+
+	engine->pickup_idx = ENGINE_PICKUP_UNDEF;
+
+	engine_refill(engine, true);
+}
+
+/******************************************************************************
+ * The function copies the state of a game to an other engine, which was
+ * created with the same game configuration. A picked up home area is copied
+ * from its backup, so the copy has no picked up home area.
+ *****************************************************************************/
+
+void engine_copy(s_engine *to, const s_engine *from) {
+
+	s_area_copy_deep(&from->game_area, &to->game_area);
+
+	for (int i = 0; i < from->home_num; i++) {
+		const s_engine_home *home = &from->home[i];
+		const s_area *src = (i == from->pickup_idx) ? &from->backup : &home->area;
+
+		blocks_copy(&src->blocks, &to->home[i].area.blocks, &home->area.dim);
+
+		s_area_sync(&to->home[i].area);
+
+		memcpy(to->home[i].norm.words, home->norm.words, sizeof(t_word) * home->norm.row_words * home->norm.dim.row);
+		s_point_copy(&to->home[i].norm_dim, &home->norm_dim);
+
+		to->home[i].droped = home->droped;
+	}
+
+	to->seed = from->seed;
+	to->rng = from->rng;
+
+	to->score = from->score;
+	to->turns = from->turns;
+	to->end = from->end;
+
+	to->pickup_idx = ENGINE_PICKUP_UNDEF;
+}
+
+/******************************************************************************
+ * If all home areas are dropped, they have to be filled again. In this case
+ * the function returns true.
+ *
+ * The force flag is used when we want to reset the game. In this case we do
+ * not want to check if refilling is necessary.
+ *****************************************************************************/
+
+bool engine_refill(s_engine *engine, const bool force) {
+
+	//
+	// If one of the home areas is not dropped, we need no refilling.
+	//
+	if (!force) {
+		for (int i = 0; i < engine->home_num; i++) {
+			if (!engine->home[i].droped) {
+				return false;
+			}
+		}
+	}
+
+	const s_game_cfg *game_cfg = engine->game_cfg;
+
+	for (int i = 0; i < engine->home_num; i++) {
+		log_debug("Filling home area: %d", i);
+
+		//
+		// Call the configured refilling function
+		//
+		(*game_cfg->fct_ptr_init_random)(game_cfg, &engine->game_data, &engine->rng, &engine->home[i].area.blocks, &engine->home[i].norm, &engine->home[i].norm_dim);
+
+		s_area_sync(&engine->home[i].area);
+
+		engine->home[i].droped = false;
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * The function computes the legal positions of the normalized form of a home
+ * area on the game area and returns their number. A dropped home area has no
+ * legal positions.
+ *****************************************************************************/
+
+int engine_home_anchors(const s_engine *engine, const int home_idx, s_bitboard *anchors) {
+
+	const s_engine_home *home = &engine->home[home_idx];
+
+	if (home->droped) {
+		bitboard_clear(anchors);
+		return 0;
+	}
+
+	return bitboard_anchors(&engine->game_area.bits, &engine->game_area.dim, &home->norm, &home->norm_dim, anchors);
+}
+
+/******************************************************************************
+ * The function checks if one of the home areas can be dropped on the game
+ * area, to test if the game actually ended. Areas that are already dropped are
+ * ignored.
+ *****************************************************************************/
+
+bool engine_can_drop_anywhere(s_engine *engine) {
+	bool result = false;
+
+	for (int i = 0; i < engine->home_num; i++) {
+
+		if (engine_home_anchors(engine, i, &engine->anchors) > 0) {
+			result = true;
+			break;
+		}
+	}
+
+	log_debug("One of the home areas can be dropped: %s", bool_str(result));
+
+	return result;
+}
+
+/******************************************************************************
+ * The function drops a normalized area at a given block index of the game
+ * area. It is required that the drop is possible.
+ *****************************************************************************/
+
+void engine_drop(s_engine *engine, const s_area *drop_area, const s_point *idx) {
+
+	log_debug("Dropping area at: %d/%d", idx->row, idx->col);
+
+	if (!s_area_drop(&engine->game_area, idx, drop_area, true)) {
+		log_exit("Unable to drop area at: %d/%d", idx->row, idx->col);
+	}
+}
+
+/******************************************************************************
+ * The function applies the rules of the game after an area was dropped. The
+ * number of removed blocks is added to the score and returned.
+ *****************************************************************************/
+
+int engine_remove(s_engine *engine, const s_area *drop_area, const s_point *idx) {
+
+	const int num_removed = engine->game_cfg->fct_ptr_rules_remove(&engine->rules, &engine->game_area, drop_area, idx);
+
+	engine->score += num_removed;
+
+	return num_removed;
+}
+
+/******************************************************************************
+ * The function finishes a move. The dropped home area is marked, the home
+ * areas are refilled if necessary and the end of the game is checked. The
+ * function returns true if the home areas were refilled.
+ *****************************************************************************/
+
+bool engine_end_move(s_engine *engine, const int home_idx) {
+
+	engine->home[home_idx].droped = true;
+
+	engine->turns++;
+
+	const bool refilled = engine_refill(engine, false);
+
+	//
+	// Check if we can drop one of the home areas. If not the game is
+	// finished.
+	//
+	if (!engine_can_drop_anywhere(engine)) {
+		engine->end = true;
+	}
+
+	return refilled;
+}
+
+/******************************************************************************
+ * The function applies a complete move. The home area with the given index is
+ * dropped with its normalized upper left corner at the block index of the
+ * game area. The function returns the number of removed blocks or
+ * ENGINE_ILLEGAL if the move is not possible.
+ *****************************************************************************/
+
+int engine_apply_move(s_engine *engine, const int home_idx, const s_point *idx) {
+
+	if (engine->end || home_idx < 0 || home_idx >= engine->home_num) {
+		return ENGINE_ILLEGAL;
+	}
+
+	const s_engine_home *home = &engine->home[home_idx];
+
+	if (home->droped) {
+		return ENGINE_ILLEGAL;
+	}
+
+	//
+	// Ensure that the normalized form of the home area is inside the game
+	// area and check it against the blocks of the game area.
+	//
+	if (idx->row < 0 || idx->col < 0 || idx->row + home->norm_dim.row > engine->game_area.dim.row || idx->col + home->norm_dim.col > engine->game_area.dim.col) {
+		return ENGINE_ILLEGAL;
+	}
+
+	if (!bitboard_fits(&engine->game_area.bits, &home->norm, &home->norm_dim, idx)) {
+		return ENGINE_ILLEGAL;
+	}
+
+	//
+	// Copy the home area to the drop area and normalize it. The rules need
+	// the blocks of the dropped area.
+	//
+	s_point_copy(&engine->drop_area.dim, &home->area.dim);
+
+	blocks_copy(&home->area.blocks, &engine->drop_area.blocks, &home->area.dim);
+
+	s_area_normalize(&engine->drop_area);
+
+	engine_drop(engine, &engine->drop_area, idx);
+
+	const int num_removed = engine_remove(engine, &engine->drop_area, idx);
+
+	engine_end_move(engine, home_idx);
+
+	return num_removed;
+}
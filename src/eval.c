@@ -0,0 +1,284 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "eval.h"
+#include "rules.h"
+
+/******************************************************************************
+ * The weights of the evaluation. The default weights are used for the hint.
+ *****************************************************************************/
+
+const s_eval_weights eval_weights_default = { .removed = 10, .holes = 6, .transitions = 1, .fits = 1, .no_fit = 50 };
+
+const s_eval_weights eval_weights_greedy = { .removed = 1 };
+
+/******************************************************************************
+ * The function creates the scratch data of the evaluator for a game
+ * configuration.
+ *****************************************************************************/
+
+void eval_create(s_eval *eval, const s_game_cfg *game_cfg) {
+
+	//
+	// The scratch area is a copy of the game area, so it needs the same
+	// squares.
+	//
+	s_area_create(&eval->scratch, &game_cfg->game_dim, &game_cfg->game_size);
+
+	if (game_cfg->type == TYPE_SQUARES_LINES) {
+		s_area_create_squares(&eval->scratch, game_cfg->square_dim);
+	}
+
+	rules_create_game(&eval->rules, &eval->scratch);
+
+	s_area_create(&eval->drop_area, &game_cfg->drop_dim, &game_cfg->game_size);
+
+	bitboard_create(&eval->anchors, game_cfg->game_dim.row, game_cfg->game_dim.col);
+
+	bitboard_create(&eval->fits, game_cfg->game_dim.row, game_cfg->game_dim.col);
+}
+
+/******************************************************************************
+ * The function frees the scratch data of the evaluator.
+ *****************************************************************************/
+
+void eval_free(s_eval *eval) {
+
+	s_area_free(&eval->scratch);
+
+	rules_free_game(&eval->rules);
+
+	s_area_free(&eval->drop_area);
+
+	bitboard_free(&eval->anchors);
+
+	bitboard_free(&eval->fits);
+}
+
+/******************************************************************************
+ * The function returns the mask of the bits of a word, that are columns of the
+ * bitboard.
+ *****************************************************************************/
+
+static inline t_word eval_valid(const s_point *dim, const int word) {
+	const int num = dim->col - word * WORD_BITS;
+
+	return num >= WORD_BITS ? ~(t_word) 0 : bitboard_bit(num) - 1;
+}
+
+/******************************************************************************
+ * The function counts the holes of a bitboard. A hole is an empty block,
+ * whose neighbors are all set or outside of the dimension. The neighbors are
+ * computed for a complete word, by shifting the words of the row and the
+ * words of the rows above and below. Blocks outside count as set.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int eval_holes(const s_bitboard *bb, const s_point *dim) {
+	int num = 0;
+
+	for (int row = 0; row < dim->row; row++) {
+		const t_word *ptr = bitboard_row(bb, row);
+
+		for (int word = 0; word < bb->row_words; word++) {
+			const t_word valid = eval_valid(dim, word);
+
+			const t_word empty = ~ptr[word] & valid;
+
+			if (empty == 0) {
+				continue;
+			}
+
+			//
+			// The blocks outside the columns are set.
+			//
+			const t_word cur = ptr[word] | ~valid;
+
+			const t_word prev = word > 0 ? ptr[word - 1] >> (WORD_BITS - 1) : 1;
+			const t_word next = word + 1 < bb->row_words ? ptr[word + 1] << (WORD_BITS - 1) : (t_word) 1 << (WORD_BITS - 1);
+
+			const t_word left = (cur << 1) | prev;
+			const t_word right = (cur >> 1) | next;
+
+			const t_word up = row > 0 ? bitboard_row(bb, row - 1)[word] | ~valid : ~(t_word) 0;
+			const t_word down = row + 1 < dim->row ? bitboard_row(bb, row + 1)[word] | ~valid : ~(t_word) 0;
+
+			num += __builtin_popcountll(empty & left & right & up & down);
+		}
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The function counts the transitions of a bitboard, which are the pairs of
+ * horizontal or vertical neighbors, where one block is set and the other is
+ * empty.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int eval_transitions(const s_bitboard *bb, const s_point *dim) {
+	int num = 0;
+
+	for (int row = 0; row < dim->row; row++) {
+		const t_word *ptr = bitboard_row(bb, row);
+
+		for (int word = 0; word < bb->row_words; word++) {
+
+			//
+			// The pairs of a block and its right neighbor. The last column has
+			// no right neighbor.
+			//
+			const t_word next = word + 1 < bb->row_words ? ptr[word + 1] << (WORD_BITS - 1) : 0;
+			const t_word pairs = eval_valid(dim, word) & ~((word + 1) * WORD_BITS >= dim->col ? bitboard_bit(dim->col - 1) : 0);
+
+			num += __builtin_popcountll((ptr[word] ^ ((ptr[word] >> 1) | next)) & pairs);
+
+			//
+			// The pairs of a block and its lower neighbor.
+			//
+			if (row + 1 < dim->row) {
+				num += __builtin_popcountll(ptr[word] ^ bitboard_row(bb, row + 1)[word]);
+			}
+		}
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The function computes the score of the scratch area after a move of a home
+ * area. The legal positions of the other home areas, that are not dropped,
+ * are counted.
+ *****************************************************************************/
+
+static int eval_score(s_eval *eval, const s_engine *engine, const s_eval_weights *weights, const int home_idx, const int removed) {
+	const s_area *area = &eval->scratch;
+
+	int score = weights->removed * removed;
+
+	if (weights->holes != 0) {
+		score -= weights->holes * eval_holes(&area->bits, &area->dim);
+	}
+
+	if (weights->transitions != 0) {
+		score -= weights->transitions * eval_transitions(&area->bits, &area->dim);
+	}
+
+	if (weights->fits == 0 && weights->no_fit == 0) {
+		return score;
+	}
+
+	for (int i = 0; i < engine->home_num; i++) {
+		const s_engine_home *home = &engine->home[i];
+
+		if (i == home_idx || home->droped) {
+			continue;
+		}
+
+		const int fits = bitboard_anchors(&area->bits, &area->dim, &home->norm, &home->norm_dim, &eval->fits);
+
+		if (fits == 0) {
+			score -= weights->no_fit;
+		} else {
+			score += weights->fits * min(fits, EVAL_FITS_MAX);
+		}
+	}
+
+	return score;
+}
+
+/******************************************************************************
+ * The function evaluates all legal moves of all home areas, that are not
+ * dropped, and stores the move with the highest score. For equal scores, the
+ * first move is used. The function returns false if no move is possible.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool eval_best_move(s_eval *eval, const s_engine *engine, const s_eval_weights *weights, s_eval_move *move) {
+	bool found = false;
+	s_point cur;
+
+	for (int i = 0; i < engine->home_num; i++) {
+
+		if (engine_home_anchors(engine, i, &eval->anchors) == 0) {
+			continue;
+		}
+
+		//
+		// Copy the home area to the drop area and normalize it. The rules
+		// need the blocks of the dropped area.
+		//
+		const s_area *home = &engine->home[i].area;
+
+		s_point_copy(&eval->drop_area.dim, &home->dim);
+
+		blocks_copy(&home->blocks, &eval->drop_area.blocks, &home->dim);
+
+		s_area_normalize(&eval->drop_area);
+
+		for (cur.row = 0; cur.row < eval->anchors.dim.row; cur.row++) {
+			const t_word *ptr = bitboard_row(&eval->anchors, cur.row);
+
+			for (int word = 0; word < eval->anchors.row_words; word++) {
+
+				for (t_word mask = ptr[word]; mask != 0; mask &= mask - 1) {
+					cur.col = word * WORD_BITS + __builtin_ctzll(mask);
+
+					//
+					// Drop the area on the copy of the game area and apply the
+					// rules.
+					//
+					s_area_copy_deep(&engine->game_area, &eval->scratch);
+
+					if (!s_area_drop(&eval->scratch, &cur, &eval->drop_area, true)) {
+						log_exit("Unable to drop area at: %d/%d", cur.row, cur.col);
+					}
+
+					const int removed = engine->game_cfg->fct_ptr_rules_remove(&eval->rules, &eval->scratch, &eval->drop_area, &cur);
+
+					const int score = eval_score(eval, engine, weights, i, removed);
+
+					if (!found || score > move->score) {
+						found = true;
+
+						move->home_idx = i;
+						s_point_copy(&move->idx, &cur);
+						move->removed = removed;
+						move->score = score;
+					}
+				}
+			}
+		}
+	}
+
+	if (found) {
+		log_debug("Best move - home: %d idx: %d/%d score: %d", move->home_idx, move->idx.row, move->idx.col, move->score);
+	}
+
+	return found;
+}
@@ -33,32 +33,15 @@
 #include "info_area.h"
 #include "home_area.h"
 #include "bg_area.h"
-#include "rules.h"
-
- /******************************************************************************
-  * Definition of a sleep time. It is used between the dropping of an area and
-  * the deletion of blocks. The pause gives the user the chance to see, why the
-  * blocks are removed. On debug mode the sleep time is higher.
-  *****************************************************************************/
-
-#ifdef DEBUG
-
-#define USLEEP 800000
-
-#else
-
-#define USLEEP 200000
-
-#endif
+#include "s_area_print.h"
+#include "anim.h"
+#include "regions.h"
+#include "render.h"
 
   /******************************************************************************
    * Definition of the meaning of a flag that make the code more readable.
    *****************************************************************************/
 
-#define DO_PRINT true
-
-#define DO_DELETE false
-
 #define LAYOUT_HORIZONTAL true
 
 #define LAYOUT_VERTICAL false
@@ -79,26 +62,54 @@
 	 *****************************************************************************/
 
 	 //
-	 // The game area struct
+	 // The window used for the game. The data of the game is part of the
+	 // engine of the s_status struct.
 	 //
-static s_area _game_area = { .blocks = NULL };
+static WINDOW *_win_game = NULL;
 
 //
-// The drop area struct
+// The render backend, which is the game window or a virtual terminal.
 //
-static s_area _drop_area = { .blocks = NULL };
+static s_render _render;
 
 //
-// The window used for the game.
+// The cell buffer of the game window, which is flushed to the render backend
+// on refresh.
 //
-static WINDOW *_win_game = NULL;
+static s_cells _cells;
+
+//
+// The layer with the static areas: the game area, the home areas, the info
+// area and the background. The areas are printed to the layer, only if they
+// change. On refresh, the layer is copied to the cell buffer and the drop
+// area is composed on top of it.
+//
+static s_cells _layer;
+
+//
+// The flag indicates whether the drop area is shown on top of the layer.
+//
+static bool _drop_visible = false;
+
+//
+// The region map of the game window, which is rebuilt with the layout.
+//
+static s_regions _regions = { .dim = { 0, 0 }, .map = NULL };
+
+//
+// The animation of a drop and the block index of the game area, where the
+// drop area is dropped.
+//
+static s_anim _anim;
+
+static s_point _drop_point;
 
 /******************************************************************************
  * The function prints a block of a drop area at a given position, with a given
  * color. The block may overlap areas (game_area, info_area, background area).
  *****************************************************************************/
 
-static void game_print_foreground(WINDOW *win, const s_status *status, const s_area *game_area, const s_point *drop_area_pos, const s_point *drop_area_size, const t_block da_color) {
+static void game_print_foreground(s_cells *cells, const s_status *status, const s_area *game_area, const s_point *drop_area_pos, const s_point *drop_area_size, const t_block da_color) {
 	s_point pixel;
 
 	//
@@ -108,42 +119,51 @@ static void game_print_foreground(WINDOW *win, const s_status *status, const s_a
 		for (pixel.col = drop_area_pos->col; pixel.col < drop_area_pos->col + drop_area_size->col; pixel.col++) {
 
 			//
-			// Check the position of each block pixel.
+			// Get the region of each block pixel from the region map.
 			//
-			if (s_area_is_inside(game_area, &pixel)) {
-				s_area_print_chess_pixel(win, game_area, &pixel, da_color, status->game_cfg->chess_type);
+			const s_region *region = regions_get(&_regions, &pixel);
+
+			switch (region->type) {
 
-			} else if (info_area_contains(&pixel)) {
-				info_area_print_pixel(win, &pixel, da_color);
+			case REGION_GAME:
+				s_area_print_chess_pixel(cells, game_area, &pixel, &region->block, da_color, status->game_cfg->chess_type);
+				break;
 
-			} else if (home_area_get_idx(&pixel) >= 0) {
-				home_area_print_pixel(win, status, &pixel, da_color);
+			case REGION_INFO:
+				info_area_print_pixel(cells, &pixel, da_color);
+				break;
 
-			} else {
-				bg_area_print_pixel(win, &pixel, da_color);
+			case REGION_HOME:
+				home_area_print_pixel(cells, &status->engine, region->idx, &pixel, &region->block, da_color);
+				break;
+
+			default:
+				bg_area_print_pixel(cells, &pixel, da_color);
 			}
 		}
 	}
 }
 
 /******************************************************************************
- * The function processes all blocks. For each block, the upper left pixel
- * (terminal character) is computed.
+ * The function prints all blocks of the drop area. For each block, the upper
+ * left pixel (terminal character) is computed.
  *****************************************************************************/
 
-static void drop_area_process_blocks(WINDOW *win, const s_status *status, const s_area *game_area, const s_area *drop_area, const bool do_print) {
+static void drop_area_print_blocks(s_cells *cells, const s_status *status, const s_area *game_area, const s_area *drop_area) {
 	s_point drop_area_ul;
 	s_point idx;
 
 	log_debug("drop area pos: %d/%d", drop_area->pos.row, drop_area->pos.col);
 
 	for (idx.row = 0; idx.row < drop_area->dim.row; idx.row++) {
+		const t_block *ptr = blocks_row(&drop_area->blocks, idx.row);
+
 		for (idx.col = 0; idx.col < drop_area->dim.col; idx.col++) {
 
 			//
 			// If the drop area block is empty, there is nothing to do.
 			//
-			if (drop_area->blocks[idx.row][idx.col] == CLR_NONE) {
+			if (ptr[idx.col] == CLR_NONE) {
 				continue;
 			}
 
@@ -153,12 +173,7 @@ static void drop_area_process_blocks(WINDOW *win, const s_status *status, const
 			//
 			drop_area_ul = s_area_get_ul(drop_area, &idx);
 
-			if (do_print) {
-				game_print_foreground(win, status, game_area, &drop_area_ul, &drop_area->size, drop_area->blocks[idx.row][idx.col]);
-
-			} else {
-				game_print_foreground(win, status, game_area, &drop_area_ul, &drop_area->size, CLR_NONE);
-			}
+			game_print_foreground(cells, status, game_area, &drop_area_ul, &drop_area->size, ptr[idx.col]);
 		}
 	}
 
@@ -203,68 +218,37 @@ static bool do_adjust(const s_area *game_area, const s_area *drop_area, s_area *
  * The function moves the drop area to a given position.
  *****************************************************************************/
 
-static void animate_move(WINDOW *win, const s_status *status, s_area *game_area, s_area *drop_area, const s_point *to) {
+static void animate_move(s_area *drop_area, const s_point *to) {
 
 	log_debug("Move from: %d/%d to: %d/%d", drop_area->pos.row, drop_area->pos.col, to->row, to->col);
 
 	//
-	// If the drop area is already at the position, there is nothing to do.
-	//
-	if (s_point_same(&drop_area->pos, to)) {
-		return;
-	}
-
-	//
-	// Delete the drop area at the old position.
-	//
-	drop_area_process_blocks(win, status, game_area, &_drop_area, DO_DELETE);
-
-	//
-	// Move the drop area to the new position.
+	// Move the drop area to the new position. It is composed on top of the
+	// layer with the next refresh.
 	//
 	s_point_copy(&drop_area->pos, to);
-
-	//
-	// Print and show the drop area at the new position.
-	//
-	drop_area_process_blocks(win, status, game_area, &_drop_area, DO_PRINT);
-
-	nzc_win_refresh(win);
-
-	//
-	// Sleep to show the movement
-	//
-	if (usleep(USLEEP) == -1) {
-		log_exit("Sleep failed: %s", strerror(errno));
-	}
 }
 
 /******************************************************************************
  * The function drops the drop area at a given position.
  *****************************************************************************/
 
-static void animate_drop(WINDOW *win, const s_status *status, s_area *game_area, const s_point *drop_point, const s_area *drop_area) {
+static void animate_drop(s_status *status, const s_point *drop_point, const s_area *drop_area) {
 
 	log_debug("Dropping drop area: %d/%d at game: %d/%d", drop_area->pos.row, drop_area->pos.col, drop_point->row, drop_point->col);
 
 	//
 	// Drop the used area.
 	//
-	s_area_drop(game_area, drop_point, drop_area, true);
+	engine_drop(&status->engine, drop_area, drop_point);
 
 	//
-	// Delete the drop area from the foreground
+	// The blocks are now part of the game area, so the game area is printed
+	// to the layer and the drop area is no longer shown.
 	//
-	drop_area_process_blocks(win, status, &_game_area, &_drop_area, DO_DELETE);
-
-	nzc_win_refresh(win);
+	s_area_print_chess(&_layer, &status->engine.game_area, status->game_cfg->chess_type);
 
-	//
-	// Sleep to show the movement
-	//
-	if (usleep(USLEEP) == -1) {
-		log_exit("Sleep failed: %s", strerror(errno));
-	}
+	_drop_visible = false;
 }
 
 /******************************************************************************
@@ -310,15 +294,16 @@ static bool game_area_can_drop(s_area *game_area, s_point *drop_point, const s_a
 
 /******************************************************************************
  * The function computes the layout of the game. The home area is printed
- * horizontal under the info area and both right to the game area.
+ * horizontal under the info area and both right to the game area. The region
+ * map is rebuilt with the new positions.
  *****************************************************************************/
 
-static void layout_horizontal(const s_point *win_size, const s_point *game_area_size, const s_point *info_area_size, const s_point *delim) {
+static void layout_horizontal(s_engine *engine, const s_point *win_size, const s_point *game_area_size, const s_point *info_area_size, const s_point *delim) {
 
 	//
 	// Compute the size of the home area.
 	//
-	const s_point home_area_size = home_area_get_size(LAYOUT_HORIZONTAL);
+	const s_point home_area_size = home_area_get_size(engine, LAYOUT_HORIZONTAL);
 
 	//
 	// Compute the size of all areas.
@@ -337,19 +322,33 @@ static void layout_horizontal(const s_point *win_size, const s_point *game_area_
 	//
 	// Set the position of the game area, which is the upper left corner.
 	//
-	s_point_set(&_game_area.pos, ul_row, ul_col);
+	s_point_set(&engine->game_area.pos, ul_row, ul_col);
 
 	//
 	// Set the position of the info area, which is top right to the game area.
 	//
-	info_area_set_pos(ul_row, ul_col + game_area_size->col + delim->col);
+	const s_point info_pos = { ul_row, ul_col + game_area_size->col + delim->col };
+	info_area_set_pos(info_pos.row, info_pos.col);
 
 	//
 	// Set the position of the home area, which is right to the game area and
 	// under the info area.
 	//
-	const s_point home_pos = { ul_row + info_area_size->row + delim->row, _game_area.pos.col + game_area_size->col + delim->col };
-	home_area_layout(&home_pos, LAYOUT_HORIZONTAL);
+	const s_point home_pos = { ul_row + info_area_size->row + delim->row, engine->game_area.pos.col + game_area_size->col + delim->col };
+	home_area_layout(engine, &home_pos, LAYOUT_HORIZONTAL);
+
+	//
+	// Rebuild the region map. The areas do not overlap.
+	//
+	regions_reset(&_regions, win_size);
+
+	regions_add_area(&_regions, REGION_GAME, -1, &engine->game_area);
+
+	regions_add_rect(&_regions, REGION_INFO, &info_pos, info_area_size);
+
+	for (int i = 0; i < engine->home_num; i++) {
+		regions_add_area(&_regions, REGION_HOME, i, &engine->home[i].area);
+	}
 }
 
 /******************************************************************************
@@ -362,15 +361,16 @@ static inline void game_mv_possible_pos(s_status *status) {
 
 	//
 	// Get the index of the first position where the drop area can be dropped.
+	// The legal positions were computed on pickup.
 	//
-	if (!s_area_can_drop_anywhere(&_game_area, &_drop_area, &idx)) {
+	if (!bitboard_first(&status->engine.anchors, &idx)) {
 		log_exit_str("Unexpected end!");
 	}
 
 	//
 	// Get the absolute upper left position of the index.
 	//
-	const s_point pos = s_area_get_ul(&_game_area, &idx);
+	const s_point pos = s_area_get_ul(&status->engine.game_area, &idx);
 
 	log_debug("Possible - idx: %d/%d - pos: %d/%d", idx.row, idx.col, pos.row, pos.col);
 
@@ -383,10 +383,10 @@ static inline void game_mv_possible_pos(s_status *status) {
 /******************************************************************************
  * The function creates and initializes all data structures for a new game of
  * a given type. The s_game_cfg struct contains the definition of the selected
- * game.
+ * game. The seed defines the random blocks of the home areas.
  *****************************************************************************/
 
-void game_create_game(const s_status *status) {
+void game_create_game(s_status *status, const uint32_t seed) {
 
 	//
 	// Save the game configuration to a variable for easier access.
@@ -395,33 +395,21 @@ void game_create_game(const s_status *status) {
 	log_debug("Create game: %s", game_cfg->title);
 
 	//
-	// Create and initialize the game area.
+	// Create the engine, which creates the game area, the drop area and the
+	// home areas.
 	//
-	s_area_create(&_game_area, &game_cfg->game_dim, &game_cfg->game_size);
+	engine_create(&status->engine, game_cfg, seed);
 
-	blocks_set(_game_area.blocks, &_game_area.dim, CLR_NONE);
-
-	log_debug("game_area pos: %d/%d", _game_area.pos.row, _game_area.pos.col);
+	eval_create(&status->eval, game_cfg);
 
 	//
-	// Create the drop area
+	// Start the search of the hint for the new game.
 	//
-	s_area_create(&_drop_area, &status->game_cfg->drop_dim, &game_cfg->game_size);
+	hint_create(&status->hint, &status->engine);
 
-	//
-	// Create and initialize the rules for the game.
-	//
-	rules_create_game(&_game_area);
+	hint_request(&status->hint, &status->engine);
 
-	//
-	// Set / load game data
-	//
-	game_cfg->fct_ptr_set_data(status->game_cfg->data);
-
-	//
-	// Create and initialize thehome area
-	//
-	home_area_create_game(status->game_cfg);
+	log_debug("game_area pos: %d/%d", status->engine.game_area.pos.row, status->engine.game_area.pos.col);
 
 	//
 	// Initialize the info area
@@ -434,114 +422,208 @@ void game_create_game(const s_status *status) {
  * game does not started.
  *****************************************************************************/
 
-void game_free_game(const s_status *status) {
-
-	log_debug("Freeing game area: %d/%d", _game_area.dim.row, _game_area.dim.col);
-
-	s_area_free(&_game_area);
-
-	rules_free_game(&_game_area);
+void game_free_game(s_status *status) {
 
 	//
-	// Without game configuration, we cannot free the drop area.
+	// Without game configuration, no game was created.
 	//
-	if (status->game_cfg != NULL) {
-
-		log_debug("Freeing drop area: %d/%d", _drop_area.dim.row, _drop_area.dim.col);
+	if (status->game_cfg == NULL) {
+		log_debug_str("No game to free!");
+		return;
+	}
 
-		//
-		// The normalization of the drop area changes the dimension. To be able
-		// to free the drop area, we have to reset the dimension.
-		//
-		s_point_set(&_drop_area.dim, status->game_cfg->drop_dim.row, status->game_cfg->drop_dim.col);
+	//
+	// The worker of the hint uses the engine, so it is stopped first.
+	//
+	hint_free(&status->hint);
 
-		s_area_free(&_drop_area);
-	}
+	engine_free(&status->engine);
 
-	home_area_free_game();
+	eval_free(&status->eval);
 }
 
 /******************************************************************************
- * The function processes a new "released" event. This requires checking if the
- * drop area can be dropped, and if so, if the game ended.
+ * The function finishes a drop, after the animation. The rules are applied,
+ * the home areas are refilled if necessary and the end of the game is checked.
  *****************************************************************************/
 
-bool game_event_drop(s_status *status) {
+static void game_drop_finish(s_status *status) {
+
+	const int num_removed = engine_remove(&status->engine, &status->engine.drop_area, &_drop_point);
+
+	if (num_removed > 0) {
+		info_area_update_score_turns(&_layer, status, num_removed);
+		s_area_print_chess(&_layer, &status->engine.game_area, status->game_cfg->chess_type);
+
+	} else {
+		info_area_new_turn(&_layer, status);
+	}
 
 	//
-	// Maybe the drop area position has to be adjusted.
+	// Mark the home area as dropped. This also means not picked up. The
+	// engine refills the home areas if necessary and checks the end of
+	// the game.
 	//
-	s_area adj_area;
+	const bool refilled = engine_end_move(&status->engine, home_area_drop(&status->engine));
 
 	//
-	// The block index of the upper left corner of the game, where the drop
-	// area is dropped.
+	// Mark the drop area as not picked up.
 	//
-	s_point drop_point;
+	s_status_undo_pickup(status);
+
+	if (refilled) {
+		home_area_print(&_layer, &status->engine);
+	}
 
 	//
-	// The button was released, so we check if we can drop the drop area.
+	// The game changed, so the hint has to be searched again.
 	//
-	if (game_area_can_drop(&_game_area, &drop_point, &_drop_area, &adj_area)) {
+	hint_request(&status->hint, &status->engine);
 
-		//
-		// Move the drop area to the adjusted position if necessary.
-		//
-		animate_move(_win_game, status, &_game_area, &_drop_area, &adj_area.pos);
+	//
+	// If there is no home area that can be dropped, the game is finished.
+	//
+	if (engine_is_end(&status->engine)) {
 
 		//
-		// Drop the drop area.
+		// If there is no place to drop it, we finished.
 		//
-		animate_drop(_win_game, status, &_game_area, &drop_point, &_drop_area);
+		s_status_set_end(status);
+		info_area_set_end(&_layer, status);
+		log_debug_str("ENDDDDDDDDDDDDD");
+	}
+}
 
-		const int num_removed = status->game_cfg->fct_ptr_rules_remove(&_game_area);
+/******************************************************************************
+ * The function does the next step of the drop animation. After the movement
+ * to the adjusted position, the drop area is dropped. After the drop, the
+ * blocks are removed and the animation ends.
+ *****************************************************************************/
 
-		if (num_removed > 0) {
-			info_area_update_score_turns(_win_game, status, num_removed);
-			s_area_print_chess(_win_game, &_game_area, status->game_cfg->chess_type);
+static void game_anim_step(s_status *status, const long now) {
 
-		} else {
-			info_area_new_turn(_win_game, status);
-		}
+	switch (_anim.state) {
 
-		//
-		// Dropping the drop area means copying the blocks to the background.
-		// After this, the drop area can be deleted from the foreground.
-		//
-		drop_area_process_blocks(_win_game, status, &_game_area, &_drop_area, DO_DELETE);
+	case ANIM_MOVE:
+		animate_drop(status, &_drop_point, &status->engine.drop_area);
+		anim_start(&_anim, ANIM_DROP, now);
+		break;
 
-		//
-		// Mark the home area as dropped. This also means not picked up.
-		//
-		home_area_mark_drop();
+	case ANIM_DROP:
+		anim_stop(&_anim);
+		game_drop_finish(status);
+		break;
 
-		//
-		// Mark the drop area as not picked up.
-		//
-		s_status_undo_pickup(status);
+	default:
+		log_exit("Unexpected state: %d", _anim.state);
+	}
+}
 
-		if (home_area_refill(status->game_cfg, false)) {
-			home_area_print(_win_game, status);
-		}
+/******************************************************************************
+ * The function checks whether a drop animation is running. In this case the
+ * game is in a transition and events, that change the game, have to finish
+ * the animation first.
+ *****************************************************************************/
 
-		//
-		// Check if we can drop one of the home areas. If not the game is
-		// finished.
-		//
-		if (!home_area_can_drop_anywhere(&_game_area)) {
+bool game_anim_is_running() {
+	return anim_is_running(&_anim);
+}
 
-			//
-			// If there is no place to drop it, we finished.
-			//
-			s_status_set_end(status);
-			info_area_set_end(_win_game, status);
-			log_debug_str("ENDDDDDDDDDDDDD");
-		}
+/******************************************************************************
+ * The function plays the frames of the animation, whose deadline is reached.
+ * It is called by the input loop. The function returns true if a frame was
+ * played, so the window has to be refreshed.
+ *****************************************************************************/
 
-		return true;
+bool game_anim_tick(s_status *status) {
+	const long now = anim_now();
+	bool changed = false;
+
+	while (anim_is_due(&_anim, now)) {
+		game_anim_step(status, now);
+		changed = true;
 	}
 
-	return false;
+	return changed;
+}
+
+/******************************************************************************
+ * The function skips the remaining frames of a running animation. After this
+ * the drop is finished.
+ *****************************************************************************/
+
+void game_anim_finish(s_status *status) {
+
+	while (anim_is_running(&_anim)) {
+		game_anim_step(status, anim_now());
+	}
+}
+
+/******************************************************************************
+ * The function returns the time in milliseconds until the deadline of the
+ * next frame of the animation, which is the timeout of the event loop. A value
+ * of -1 means no timeout.
+ *****************************************************************************/
+
+int game_timeout() {
+	return anim_timeout(&_anim, anim_now());
+}
+
+/******************************************************************************
+ * The function sets the duration of an animation frame. A value of 0 disables
+ * the animation.
+ *****************************************************************************/
+
+void game_set_anim_delay(const long delay) {
+	anim_init(&_anim, delay);
+}
+
+/******************************************************************************
+ * The function processes a new "released" event. This requires checking if the
+ * drop area can be dropped. If so, the drop animation is started, which
+ * finishes the drop later. The function returns true if the drop area is
+ * dropped.
+ *****************************************************************************/
+
+bool game_event_drop(s_status *status) {
+
+	//
+	// Maybe the drop area position has to be adjusted.
+	//
+	s_area adj_area;
+
+	//
+	// The button was released, so we check if we can drop the drop area. The
+	// block index of the upper left corner of the game, where the drop area
+	// is dropped, is stored for the animation.
+	//
+	if (!game_area_can_drop(&status->engine.game_area, &_drop_point, &status->engine.drop_area, &adj_area)) {
+		return false;
+	}
+
+	const long now = anim_now();
+
+	//
+	// Move the drop area to the adjusted position if necessary. The drop is
+	// done after the first frame.
+	//
+	if (!s_point_same(&status->engine.drop_area.pos, &adj_area.pos)) {
+		animate_move(&status->engine.drop_area, &adj_area.pos);
+		anim_start(&_anim, ANIM_MOVE, now);
+
+	} else {
+		animate_drop(status, &_drop_point, &status->engine.drop_area);
+		anim_start(&_anim, ANIM_DROP, now);
+	}
+
+	//
+	// Without animation, the drop is finished directly.
+	//
+	if (_anim.delay == 0) {
+		game_anim_finish(status);
+	}
+
+	return true;
 }
 
 /******************************************************************************
@@ -550,36 +632,53 @@ bool game_event_drop(s_status *status) {
  * necessary.
  *****************************************************************************/
 
-void game_do_center(const s_status *status) {
+void game_do_center(s_status *status) {
 
-	const s_point game_area_size = s_area_get_size(&_game_area);
+	const s_point game_area_size = s_area_get_size(&status->engine.game_area);
 
 	const s_point info_area_size = info_area_get_size();
 
-	const s_point win_size = { getmaxy(_win_game), getmaxx(_win_game) };
+	const s_point win_size = render_get_dim(&_render);
 
-	layout_horizontal(&win_size, &game_area_size, &info_area_size, &status->game_cfg->game_size);
+	layout_horizontal(&status->engine, &win_size, &game_area_size, &info_area_size, &status->game_cfg->game_size);
 
 	//
-	// Delete the old content.
+	// Delete the old content of the layer. The window content may be changed
+	// by a menu, so the next flush has to write all cells.
 	//
-	werase(_win_game);
+	cells_resize(&_layer, win_size.row, win_size.col);
 
-	//
-	// Print the areas at the updated position.
-	//
-	s_area_print_chess(_win_game, &_game_area, status->game_cfg->chess_type);
+	cells_resize(&_cells, win_size.row, win_size.col);
+
+	cells_clear(&_layer);
 
-	home_area_print(_win_game, status);
+	cells_invalidate(&_cells);
 
 	//
-	// If the drop area is picked up, we need to print it.
+	// Print the areas at the updated position. A picked up drop area is
+	// composed on refresh.
 	//
-	if (s_status_is_picked_up(status)) {
-		drop_area_process_blocks(_win_game, status, &_game_area, &_drop_area, DO_PRINT);
-	}
+	s_area_print_chess(&_layer, &status->engine.game_area, status->game_cfg->chess_type);
 
-	info_area_print(_win_game, status);
+	home_area_print(&_layer, &status->engine);
+
+	info_area_print(&_layer, status);
+}
+
+/******************************************************************************
+ * The function initializes the data, that does not depend on the render
+ * backend. The cell buffers have the dimension of the backend.
+ *****************************************************************************/
+
+static void game_init_render() {
+
+	anim_init(&_anim, ANIM_DELAY_MS);
+
+	const s_point dim = render_get_dim(&_render);
+
+	cells_create(&_cells, dim.row, dim.col, color_default_bg());
+
+	cells_create(&_layer, dim.row, dim.col, color_default_bg());
 }
 
 /******************************************************************************
@@ -593,6 +692,10 @@ void game_init() {
 	//
 	_win_game = nzc_win_create_fully();
 
+	render_curses(&_render, _win_game);
+
+	game_init_render();
+
 	//
 	// Set the default color pairs
 	//
@@ -606,20 +709,43 @@ void game_init() {
 	nzc_win_refresh(stdscr);
 }
 
+/******************************************************************************
+ * The function initializes the game with a virtual terminal, which replaces
+ * the game window. No terminal is necessary.
+ *****************************************************************************/
+
+void game_init_vterm(s_vterm *vterm) {
+
+	render_vterm(&_render, vterm);
+
+	game_init_render();
+}
+
 /******************************************************************************
  * The function frees the allocated memory.
  *****************************************************************************/
 
 void game_free() {
 
+	cells_free(&_cells);
+
+	cells_free(&_layer);
+
+	regions_free(&_regions);
+
+	//
+	// The window is not created for a virtual terminal.
+	//
 	nzc_win_del(_win_game);
+
+	_win_game = NULL;
 }
 
 /******************************************************************************
  * The function resets the game on the user input.
  *****************************************************************************/
 
-void game_reset(s_status *status) {
+void game_reset(s_status *status, const uint32_t seed) {
 
 	//
 	// Initialize the game status
@@ -627,32 +753,32 @@ void game_reset(s_status *status) {
 	s_status_init(status, status->game_cfg);
 
 	//
-	// Reset the game area
+	// Reset the game area, remove the picked up mark and refill the home
+	// areas.
 	//
-	s_area_set_blocks(&_game_area, 0);
+	engine_reset(&status->engine, seed);
 
-	//
-	// Move the drop area to the home position.
-	//
-	home_area_reset(status->game_cfg);
+	_drop_visible = false;
+
+	hint_request(&status->hint, &status->engine);
 }
 
 /******************************************************************************
- * The function refreshes the game window.
+ * The function refreshes the game window. The drop area is composed on top of
+ * the layer and the changed cells are written to the render backend.
  *****************************************************************************/
 
-void game_win_refresh() {
+void game_win_refresh(const s_status *status) {
 
-	//
-	// Move the cursor to a save place and do the refreshing. If the cursor
-	// is not moved a flickering can occur. (I am not sure if this is necessary
-	// for this game, but I had trouble with it in the past)
-	//
-	if (wmove(_win_game, 0, 0) == ERR) {
-		log_exit_str("Unable to move the cursor!");
+	cells_copy(&_cells, &_layer);
+
+	if (_drop_visible) {
+		drop_area_print_blocks(&_cells, status, &status->engine.game_area, &status->engine.drop_area);
 	}
 
-	nzc_win_refresh(_win_game);
+	render_flush(&_render, &_cells);
+
+	render_show(&_render);
 }
 
 // ------------------------- events
@@ -679,24 +805,15 @@ void game_event_move(s_status *status, const s_point *event) {
 	//
 	// If the position did not changed, we do nothing.
 	//
-	if (s_area_same_pos(&_drop_area, event->row, event->col)) {
+	if (s_area_same_pos(&status->engine.drop_area, event->row, event->col)) {
 		return;
 	}
 
 	//
-	// Delete the drop area at its old position.
-	//
-	drop_area_process_blocks(_win_game, status, &_game_area, &_drop_area, DO_DELETE);
-
-	//
-	// Set the new position of the drop area.
+	// Set the new position of the drop area. It is composed on top of the
+	// layer with the next refresh.
 	//
-	s_status_update_pos(status, &_drop_area.pos, event);
-
-	//
-	// Print the drop area at the new position.
-	//
-	drop_area_process_blocks(_win_game, status, &_game_area, &_drop_area, DO_PRINT);
+	s_status_update_pos(status, &status->engine.drop_area.pos, event);
 }
 
 /******************************************************************************
@@ -722,29 +839,31 @@ void game_process_do_pickup(s_status *status, const s_point *event) {
 	// If we can pickup something, we mark the home area as picked up
 	// and print the empty home area.
 	//
-	if (!home_area_pickup(&_drop_area, event)) {
+	if (!home_area_pickup(&status->engine, event)) {
 		return;
 	}
-	home_area_print(_win_game, status);
+	home_area_print(&_layer, &status->engine);
+
+	//
+	// Compute the legal positions of the new drop area.
+	//
+	s_area_legal_anchors(&status->engine.game_area, &status->engine.drop_area, &status->engine.anchors);
 
 	//
 	// If the event is inside the home area we compute the exact position.
 	//
-	if (s_area_is_inside(&_drop_area, event)) {
-		s_status_pickup(status, event->row - _drop_area.pos.row, event->col - _drop_area.pos.col);
+	if (s_area_is_inside(&status->engine.drop_area, event)) {
+		s_status_pickup(status, event->row - status->engine.drop_area.pos.row, event->col - status->engine.drop_area.pos.col);
 	} else {
 		s_status_pickup(status, 0, 0);
 	}
 
 	//
-	// Set the new position of the drop area.
+	// Set the new position of the drop area and show it.
 	//
-	s_status_update_pos(status, &_drop_area.pos, event);
+	s_status_update_pos(status, &status->engine.drop_area.pos, event);
 
-	//
-	// Print the drop area at the new position.
-	//
-	drop_area_process_blocks(_win_game, status, &_game_area, &_drop_area, DO_PRINT);
+	_drop_visible = true;
 }
 
 /******************************************************************************
@@ -755,9 +874,9 @@ void game_process_do_pickup(s_status *status, const s_point *event) {
 void game_process_event_undo_pickup(s_status *status) {
 
 	//
-	// Delete the drop area from the old position.
+	// Remove the drop area from the old position.
 	//
-	drop_area_process_blocks(_win_game, status, &_game_area, &_drop_area, DO_DELETE);
+	_drop_visible = false;
 
 	//
 	// Mark the status as not picked up
@@ -767,8 +886,8 @@ void game_process_event_undo_pickup(s_status *status) {
 	//
 	// Mark the home area as not picked up.
 	//
-	home_area_undo_pickup();
-	home_area_print(_win_game, status);
+	home_area_undo_pickup(&status->engine);
+	home_area_print(&_layer, &status->engine);
 }
 
 /******************************************************************************
@@ -778,7 +897,7 @@ void game_process_event_undo_pickup(s_status *status) {
 
 void game_event_keyboard_mv(s_status *status, const int diff_row, const int diff_col) {
 
-	log_debug("Drop area: %d/%d diff: %d/%d", _drop_area.pos.row, _drop_area.pos.col, diff_row, diff_col);
+	log_debug("Drop area: %d/%d diff: %d/%d", status->engine.drop_area.pos.row, status->engine.drop_area.pos.col, diff_row, diff_col);
 
 	//
 	// We cannot move an area which is not picked up.
@@ -792,9 +911,9 @@ void game_event_keyboard_mv(s_status *status, const int diff_row, const int diff
 	//
 	s_status_keyboard_event(status);
 
-	if (s_area_is_area_inside(&_game_area, &_drop_area)) {
+	if (s_area_is_area_inside(&status->engine.game_area, &status->engine.drop_area)) {
 
-		s_point event = { .row = _drop_area.pos.row, .col = _drop_area.pos.col };
+		s_point event = { .row = status->engine.drop_area.pos.row, .col = status->engine.drop_area.pos.col };
 
 		//
 		// The alignment is only necessary if the control switches from mouse
@@ -802,12 +921,12 @@ void game_event_keyboard_mv(s_status *status, const int diff_row, const int diff
 		//
 		// TODO: the function s_area_move_inner_area() assumes that the event
 		// point is the position of the drop area.
-		const bool aligned = s_area_align_point(&_game_area, &event);
+		const bool aligned = s_area_align_point(&status->engine.game_area, &event);
 
 		//
 		// Move the drop area if possible.
 		//
-		const bool moved = s_area_move_inner_area(&_game_area, &_drop_area, &event, &(s_point) { diff_row, diff_col });
+		const bool moved = s_area_move_inner_area(&status->engine.game_area, &status->engine.drop_area, &event, &(s_point) { diff_row, diff_col });
 
 		if (aligned || moved) {
 			game_event_move(status, &event);
@@ -843,7 +962,7 @@ void game_event_next_home_area(s_status *status) {
 		// Get the next unused home area. If one one unused home area was left,
 		// the function returns false.
 		//
-		const bool found = home_area_next_unused(&unused);
+		const bool found = home_area_next_unused(&status->engine, &unused);
 
 		//
 		// If an new unused home area was found, we switch to this home area.
@@ -862,10 +981,65 @@ void game_event_next_home_area(s_status *status) {
 	else {
 		s_point unused;
 
-		if (!home_area_next_unused(&unused)) {
+		if (!home_area_next_unused(&status->engine, &unused)) {
 			log_exit_str("No unused found!");
 		}
 
 		game_process_do_pickup(status, &unused);
 	}
 }
+
+/******************************************************************************
+ * The function fetches the state of the hint, which is searched in the
+ * background, and prints it, if it changed. In this case the function returns
+ * true, so the window has to be refreshed.
+ *****************************************************************************/
+
+bool game_hint_update(s_status *status) {
+	s_eval_move move;
+
+	const e_hint_state state = hint_get(&status->hint, &move);
+
+	return info_area_update_hint(&_layer, status, state);
+}
+
+/******************************************************************************
+ * The function shows a hint. The best move is picked up and moved to its
+ * position on the game area, so the user only has to drop it. If the search
+ * in the background is not finished, the move of the evaluator is used.
+ *****************************************************************************/
+
+void game_event_hint(s_status *status) {
+	s_eval_move move;
+
+	//
+	// The evaluator needs the blocks of all home areas, so a picked up home
+	// area is moved back.
+	//
+	if (s_status_is_picked_up(status)) {
+		game_process_event_undo_pickup(status);
+	}
+
+	const e_hint_state state = hint_get(&status->hint, &move);
+
+	if (state == HINT_NONE) {
+		log_debug_str("No move found!");
+		return;
+	}
+
+	if (state == HINT_SEARCHING && !eval_best_move(&status->eval, &status->engine, &eval_weights_default, &move)) {
+		log_debug_str("No move found!");
+		return;
+	}
+
+	game_process_do_pickup(status, &status->engine.home[move.home_idx].area.pos);
+
+	//
+	// Mark as keyboard event.
+	//
+	s_status_keyboard_event(status);
+
+	const s_point pos = s_area_get_ul(&status->engine.game_area, &move.idx);
+
+	game_event_move(status, &pos);
+}
@@ -0,0 +1,243 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+
+#include "hint.h"
+
+/******************************************************************************
+ * The function is the main function of the worker thread. It waits for a new
+ * request, copies the game and searches the best move. The result is only
+ * stored, if there was no new request during the search.
+ *****************************************************************************/
+
+static void* hint_worker_run(void *arg) {
+	s_hint *hint = arg;
+
+	pthread_mutex_lock(&hint->mutex);
+
+	for (;;) {
+
+		while (!hint->stop && hint->done_gen == hint->gen) {
+			pthread_cond_wait(&hint->cond, &hint->mutex);
+		}
+
+		if (hint->stop) {
+			break;
+		}
+
+		//
+		// Copy the request, so the search can run without the lock.
+		//
+		const unsigned int gen = hint->gen;
+
+		engine_copy(&hint->engine, &hint->request);
+
+		atomic_store_explicit(&hint->cancel, false, memory_order_relaxed);
+
+		pthread_mutex_unlock(&hint->mutex);
+
+		s_eval_move move;
+		const bool found = solver_best_move(&hint->solver, &hint->engine, &move);
+
+		pthread_mutex_lock(&hint->mutex);
+
+		if (gen == hint->gen) {
+			hint->found = found;
+			hint->move = move;
+			hint->done_gen = gen;
+
+			const uint64_t one = 1;
+
+			if (write(hint->fd, &one, sizeof(one)) == -1 && errno != EAGAIN) {
+				log_exit("Unable to signal result: %s", strerror(errno));
+			}
+
+		} else {
+			log_debug("Outdated search: %u current: %u", gen, hint->gen);
+		}
+	}
+
+	pthread_mutex_unlock(&hint->mutex);
+
+	return NULL;
+}
+
+/******************************************************************************
+ * The function creates the hint for the game of the engine and starts the
+ * worker thread. The worker uses the solver with the expected value of the
+ * next refill, because the search does not block the input.
+ *****************************************************************************/
+
+void hint_create(s_hint *hint, const s_engine *engine) {
+
+	engine_create(&hint->request, engine->game_cfg, engine->seed);
+
+	engine_create(&hint->engine, engine->game_cfg, engine->seed);
+
+	solver_create(&hint->solver, engine, &eval_weights_default, SOLVER_BEAM_DEFAULT, true);
+
+	hint->solver.cancel = &hint->cancel;
+
+	atomic_init(&hint->cancel, false);
+
+	hint->gen = 0;
+	hint->done_gen = 0;
+	hint->stop = false;
+	hint->found = false;
+
+	hint->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (hint->fd == -1) {
+		log_exit("Unable to create eventfd: %s", strerror(errno));
+	}
+
+	if (pthread_mutex_init(&hint->mutex, NULL) != 0) {
+		log_exit_str("Unable to create mutex!");
+	}
+
+	if (pthread_cond_init(&hint->cond, NULL) != 0) {
+		log_exit_str("Unable to create condition!");
+	}
+
+	//
+	// The worker is started with all signals blocked, so the signals are
+	// received by the thread of the UI.
+	//
+	sigset_t mask, old_mask;
+	sigfillset(&mask);
+
+	pthread_sigmask(SIG_SETMASK, &mask, &old_mask);
+
+	const int error = pthread_create(&hint->thread, NULL, hint_worker_run, hint);
+
+	pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+
+	if (error != 0) {
+		log_exit("Unable to create thread: %s", strerror(error));
+	}
+
+	hint->started = true;
+}
+
+/******************************************************************************
+ * The function stops the worker thread and frees the hint. A hint, that was
+ * not created or is already freed, is ignored.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void hint_free(s_hint *hint) {
+
+	if (!hint->started) {
+		log_debug_str("Hint not started!");
+		return;
+	}
+
+	pthread_mutex_lock(&hint->mutex);
+
+	hint->stop = true;
+
+	atomic_store_explicit(&hint->cancel, true, memory_order_relaxed);
+
+	pthread_cond_signal(&hint->cond);
+
+	pthread_mutex_unlock(&hint->mutex);
+
+	const int error = pthread_join(hint->thread, NULL);
+
+	if (error != 0) {
+		log_exit("Unable to join thread: %s", strerror(error));
+	}
+
+	pthread_cond_destroy(&hint->cond);
+
+	pthread_mutex_destroy(&hint->mutex);
+
+	close(hint->fd);
+
+	solver_free(&hint->solver);
+
+	engine_free(&hint->engine);
+
+	engine_free(&hint->request);
+
+	hint->started = false;
+}
+
+/******************************************************************************
+ * The function starts a search for the current state of the game. A running
+ * search is canceled. The function has to be called after each change of the
+ * game.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void hint_request(s_hint *hint, const s_engine *engine) {
+
+	pthread_mutex_lock(&hint->mutex);
+
+	engine_copy(&hint->request, engine);
+
+	hint->gen++;
+
+	atomic_store_explicit(&hint->cancel, true, memory_order_relaxed);
+
+	pthread_cond_signal(&hint->cond);
+
+	pthread_mutex_unlock(&hint->mutex);
+
+	log_debug("Hint request: %u", hint->gen);
+}
+
+/******************************************************************************
+ * The function returns the state of the last request without waiting. If the
+ * search is finished and a move was found, the move is copied.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+e_hint_state hint_get(s_hint *hint, s_eval_move *move) {
+	e_hint_state state;
+
+	pthread_mutex_lock(&hint->mutex);
+
+	if (hint->done_gen != hint->gen) {
+		state = HINT_SEARCHING;
+
+	} else if (!hint->found) {
+		state = HINT_NONE;
+
+	} else {
+		*move = hint->move;
+		state = HINT_READY;
+	}
+
+	pthread_mutex_unlock(&hint->mutex);
+
+	return state;
+}
@@ -23,94 +23,38 @@
  */
 
 #include "home_area.h"
-#include "colors.h"
-
- /******************************************************************************
-  * The home area consists of areas that can be picked up. They are stored in an
-  * array with at most HOME_MAX entries. The actual number of entries is
-  * _home_num.
-  *****************************************************************************/
-
-typedef struct s_home {
-
-	//
-	// The area which can be picked up.
-	//
-	s_area area;
-
-	//
-	// A flag that says that the home area was successfully dropped.
-	//
-	bool droped;
-
-} s_home;
-
-#define HOME_MAX 3
-
-static int _home_num;
-
-static s_home _home_area[HOME_MAX];
+#include "s_area_print.h"
 
 /******************************************************************************
- * The variable contains the index of the home area, which is currently picked
- * up or PICKUP_IDX_UNDEF if no home area is picked up.
+ * The home areas, the index of the picked up home area and its backup are
+ * part of the engine. The functions of this file are responsible for the
+ * picking up and the printing of the home areas.
  *
- * The parameter has to be consistent with the s_status struct, which also has
- * a parameter (see offset), which indicates that a drop area is picked up.
- *****************************************************************************/
-
-static int _pickup_idx;
-
-#define PICKUP_IDX_UNDEF -1
-
-/******************************************************************************
- * We need blocks to store the currently picked up home area. The drop area is
- * normalized, which means, empty rows and columns are removed. So we cannot
- * use the drop area as a backup.
+ * The index of the picked up home area has to be consistent with the s_status
+ * struct, which also has a parameter (see offset), which indicates that a drop
+ * area is picked up.
  *****************************************************************************/
 
-static t_block **_blocks = NULL;
-
-static s_point _blocks_dim;
-
 /******************************************************************************
  * The function ensures that a home area is picked up.
  *****************************************************************************/
 
 #ifdef DEBUG
 
-static inline void ensure_picked_up() {
+static inline void ensure_picked_up(const s_engine *engine) {
 
 	//
 	// Ensure that the index is set and in the valid range.
 	//
-	if (_pickup_idx < 0 || _pickup_idx >= HOME_MAX) {
-		log_exit("Index out of range: %d", _pickup_idx);
+	if (engine->pickup_idx < 0 || engine->pickup_idx >= engine->home_num) {
+		log_exit("Index out of range: %d", engine->pickup_idx);
 	}
 
 	//
 	// Ensure that it is not dropped.
 	//
-	if (_home_area[_pickup_idx].droped) {
-		log_exit("Already dropped: %d", _pickup_idx);
-	}
-}
-
-#endif
-
-/******************************************************************************
- * The function ensures that a home area is NOT picked up.
- *****************************************************************************/
-
-#ifdef DEBUG
-
-static inline void ensure_not_picked_up() {
-
-	//
-	// Ensure that nothing is picked up.
-	//
-	if (_pickup_idx != PICKUP_IDX_UNDEF) {
-		log_exit("Home area is picked up: %d", _pickup_idx);
+	if (engine->home[engine->pickup_idx].droped) {
+		log_exit("Already dropped: %d", engine->pickup_idx);
 	}
 }
 
@@ -125,15 +69,15 @@ static inline void ensure_not_picked_up() {
  * layout of the home areas.
  *****************************************************************************/
 
-int home_area_get_idx(const s_point *pixel) {
-	int idx = PICKUP_IDX_UNDEF;
+int home_area_get_idx(const s_engine *engine, const s_point *pixel) {
+	int idx = ENGINE_PICKUP_UNDEF;
 
-	for (int i = 0; i < _home_num; i++) {
+	for (int i = 0; i < engine->home_num; i++) {
 
 		//
 		// Check if the current home area contains the pixel.
 		//
-		if (s_area_is_inside(&_home_area[i].area, pixel)) {
+		if (s_area_is_inside(&engine->home[i].area, pixel)) {
 			idx = i;
 			break;
 		}
@@ -145,144 +89,26 @@ int home_area_get_idx(const s_point *pixel) {
 }
 
 /******************************************************************************
- * The function checks if one of the home areas can be dropped on the game
- * area, to test if the game actually ended. Areas that are already dropped are
- * ignored.
- *
- * The function is called after an area is dropped. So there should not be a
- * home area picked up.
+ * The function is called after the picked up home area was dropped. The
+ * function returns the index of the home area, which is no longer picked up.
+ * The engine marks the home area as dropped.
  *****************************************************************************/
 
-bool home_area_can_drop_anywhere(s_area *area) {
-	bool result = false;
-
-	//
-	// Create an area and use the backup blocks. To to this, we need to ensure
-	// that nothing is picked up. In this case the blocks are not in used.
-	//
-	s_area norm_area = { .blocks = _blocks };
-
-#ifdef DEBUG
-
-	//
-	// If a home area is picked up, the blocks of the s_area are empty.
-	// So checking for dropping makes no sense.
-	//
-	ensure_not_picked_up();
-#endif
-
-	for (int i = 0; i < _home_num; i++) {
-
-		//
-		// If the home area is already dropped, there is nothing to check.
-		// Being dropped means that the home area is empty and not in use.
-		//
-		if (_home_area[i].droped) {
-			continue;
-		}
-
-		s_area_copy_deep(&_home_area[i].area, &norm_area);
-		s_area_normalize(&norm_area);
-
-		//
-		// Check if the current home area can be dropped on the game area.
-		//
-		if (s_area_can_drop_anywhere(area, &norm_area, NULL)) {
-			result = true;
-			break;
-		}
-	}
-
-	log_debug("One of the home areas can be dropped: %s", bool_str(result));
-
-	return result;
-}
-
-/******************************************************************************
- * The function marks a home area as dropped. The home area is empty until the
- * areas are refilled.
- *****************************************************************************/
-
-void home_area_mark_drop() {
+int home_area_drop(s_engine *engine) {
 
 #ifdef DEBUG
 
 	//
 	// Ensure preconditions.
 	//
-	ensure_picked_up();
+	ensure_picked_up(engine);
 #endif
 
-	_home_area[_pickup_idx].droped = true;
-
-	_pickup_idx = PICKUP_IDX_UNDEF;
-}
-
-/******************************************************************************
- * The function checks if all home areas are dropped. In this case refilling is
- * required.
- *****************************************************************************/
-
-static bool home_area_needs_refilling() {
-	bool result = true;
+	const int idx = engine->pickup_idx;
 
-	for (int i = 0; i < _home_num; i++) {
+	engine->pickup_idx = ENGINE_PICKUP_UNDEF;
 
-		//
-		// If one of the home areas is not dropped, we need no refilling
-		//
-		if (!_home_area[i].droped) {
-			result = false;
-			break;
-		}
-	}
-
-	log_debug("Needs refilling: %s", bool_str(result));
-
-	return result;
-}
-
-/******************************************************************************
- * If all home areas are empty, they have to be filled again. In this case the
- * function returns true, which indicates that the home areas have to printed
- * again.
- *
- * The force flag is used when we want to reset the game. In this case we do
- * not want to check if refilling is necessary.
- *****************************************************************************/
-
-bool home_area_refill(const s_game_cfg *game_cfg, const bool force) {
-
-#ifdef DEBUG
-
-	//
-	// Ensure preconditions.
-	//
-	ensure_not_picked_up();
-#endif
-
-	//
-	// If not all home areas are empty, there is nothing to do.
-	//
-	if (!force && !home_area_needs_refilling()) {
-		return false;
-	}
-
-	for (int i = 0; i < _home_num; i++) {
-		log_debug("Filling home area: %d", i);
-
-		//
-		// Call the configured refilling function
-		//
-		(*game_cfg->fct_ptr_init_random)(game_cfg, _home_area[i].area.blocks);
-
-		//
-		// Remove the dropped mark, which is definitely set at this point.
-		//
-		_home_area[i].droped = false;
-	}
-
-	return true;
+	return idx;
 }
 
 /******************************************************************************
@@ -293,16 +119,16 @@ bool home_area_refill(const s_game_cfg *game_cfg, const bool force) {
  * not possible.
  *****************************************************************************/
 
-bool home_area_pickup(s_area *area, const s_point *pixel) {
+bool home_area_pickup(s_engine *engine, const s_point *pixel) {
 	log_debug("picking up home area at: %d/%d", pixel->row, pixel->col);
 
-	_pickup_idx = home_area_get_idx(pixel);
+	engine->pickup_idx = home_area_get_idx(engine, pixel);
 
 	//
-	// The function returns PICKUP_IDX_UNDEF if the event is outside the home
+	// The function returns ENGINE_PICKUP_UNDEF if the event is outside the home
 	// area. In this case, there is no index.
 	//
-	if (_pickup_idx == PICKUP_IDX_UNDEF) {
+	if (engine->pickup_idx == ENGINE_PICKUP_UNDEF) {
 		log_debug_str("Event is outside the homearea!");
 		return false;
 	}
@@ -311,8 +137,8 @@ bool home_area_pickup(s_area *area, const s_point *pixel) {
 	// If the event is inside the home area, we have an index, but we have to 
 	// ensure that the area is not already empty, which means dropped.
 	//
-	if (_home_area[_pickup_idx].droped) {
-		log_debug("Home area with idx: %d is already dropped!", _pickup_idx);
+	if (engine->home[engine->pickup_idx].droped) {
+		log_debug("Home area with idx: %d is already dropped!", engine->pickup_idx);
 		return false;
 	}
 
@@ -321,13 +147,14 @@ bool home_area_pickup(s_area *area, const s_point *pixel) {
 	//
 	// Ensure that the picking up was successful.
 	//
-	ensure_picked_up();
+	ensure_picked_up(engine);
 #endif
 
 	//
 	// Save the picked up area, which is later used.
 	//
-	s_area *home_area = &_home_area[_pickup_idx].area;
+	s_area *home_area = &engine->home[engine->pickup_idx].area;
+	s_area *area = &engine->drop_area;
 
 	//
 	// The position of the drop area is the effective upper left corner.
@@ -344,13 +171,13 @@ bool home_area_pickup(s_area *area, const s_point *pixel) {
 	//
 	// Copy the home area blocks to the drop area.
 	//
-	blocks_copy(home_area->blocks, area->blocks, &home_area->dim);
+	blocks_copy(&home_area->blocks, &area->blocks, &home_area->dim);
 
 	//
 	// Create a backup of the home area. The drop area is normalized, so we
 	// cannot use it as a backup.
 	//
-	blocks_copy(home_area->blocks, _blocks, &home_area->dim);
+	blocks_copy(&home_area->blocks, &engine->backup.blocks, &home_area->dim);
 
 	//
 	// Delete the content of the picked up home area.
@@ -369,24 +196,26 @@ bool home_area_pickup(s_area *area, const s_point *pixel) {
  * The function moves a picked up home area to its position again.
  *****************************************************************************/
 
-void home_area_undo_pickup() {
+void home_area_undo_pickup(s_engine *engine) {
 
 #ifdef DEBUG
 
 	//
 	// Ensure preconditions.
 	//
-	ensure_picked_up();
+	ensure_picked_up(engine);
 #endif
 
 	//
 	// Copy the backup to the home area.
 	//
-	blocks_copy(_blocks, _home_area[_pickup_idx].area.blocks, &_home_area[_pickup_idx].area.dim);
+	blocks_copy(&engine->backup.blocks, &engine->home[engine->pickup_idx].area.blocks, &engine->home[engine->pickup_idx].area.dim);
+
+	s_area_sync(&engine->home[engine->pickup_idx].area);
 
-	_pickup_idx = PICKUP_IDX_UNDEF;
+	engine->pickup_idx = ENGINE_PICKUP_UNDEF;
 
-	log_debug("Home area restored: %d", _pickup_idx);
+	log_debug("Home area restored: %d", engine->pickup_idx);
 }
 
 /******************************************************************************
@@ -394,50 +223,45 @@ void home_area_undo_pickup() {
  * the game is CHESS_DOUBLE, then the chess type of the home areas is toggling.
  *****************************************************************************/
 
-static short home_area_get_chess_type(const s_status *status, const int home_area_idx) {
+static short home_area_get_chess_type(const s_engine *engine, const int home_area_idx) {
 
 	//
 	// On CHESS_DOUBLE even home areas have a CHESS_SIMPLE_DARK and odd have a
 	// CHESS_SIMPLE_LIGHT chess pattern.
 	//
-	if (status->game_cfg->chess_type == CHESS_DOUBLE) {
+	if (engine->game_cfg->chess_type == CHESS_DOUBLE) {
 		return home_area_idx % 2 == 0 ? CHESS_SIMPLE_DARK : CHESS_SIMPLE_LIGHT;
 	}
 
-	return status->game_cfg->chess_type;
+	return engine->game_cfg->chess_type;
 }
 
 /******************************************************************************
  * The function prints all home areas.
  *****************************************************************************/
 
-void home_area_print(WINDOW *win, const s_status *status) {
+void home_area_print(s_cells *cells, const s_engine *engine) {
 
-	for (int i = 0; i < _home_num; i++) {
+	for (int i = 0; i < engine->home_num; i++) {
 
 		log_debug("Processing home area: %d", i);
 
-		s_area_print_chess(win, &_home_area[i].area, home_area_get_chess_type(status, i));
+		s_area_print_chess(cells, &engine->home[i].area, home_area_get_chess_type(engine, i));
 	}
 }
 
 /******************************************************************************
- * The function prints a pixel. It is assumed that the pixel is inside one of
- * the home areas.
+ * The function prints a pixel of the home area with the given index. The
+ * block is the block of the home area, that contains the pixel.
  *****************************************************************************/
 
-void home_area_print_pixel(WINDOW *win, const s_status *status, const s_point *pixel, const t_block da_color) {
-
-	//
-	// Get the index of the affected home area.
-	//
-	const int idx = home_area_get_idx(pixel);
+void home_area_print_pixel(s_cells *cells, const s_engine *engine, const int idx, const s_point *pixel, const s_point *block, const t_block da_color) {
 
 	//
 	// Ensure that is is value.
 	//
-	if (idx < 0) {
-		log_exit("Index not found for pixel: %d/%d", pixel->row, pixel->col);
+	if (idx < 0 || idx >= engine->home_num) {
+		log_exit("Invalid index: %d for pixel: %d/%d", idx, pixel->row, pixel->col);
 	}
 
 	log_debug("pixel: %d/%d (idx: %d)", pixel->row, pixel->col, idx);
@@ -445,84 +269,7 @@ void home_area_print_pixel(WINDOW *win, const s_status *status, const s_point *p
 	//
 	// Print the pixel with a chess pattern as a background.
 	//
-	s_area_print_chess_pixel(win, &_home_area[idx].area, pixel, da_color, home_area_get_chess_type(status, idx));
-}
-
-/******************************************************************************
- * The function resets the home areas. The picked up mark is removed and the
- * home areas are refilled, independent of their state.
- *****************************************************************************/
-
-void home_area_reset(const s_game_cfg *game_cfg) {
-
-	_pickup_idx = PICKUP_IDX_UNDEF;
-
-	home_area_refill(game_cfg, true);
-}
-
-/******************************************************************************
- * The function frees the home area. It has to called each time a game has
- * ended.
- *****************************************************************************/
-
-void home_area_free_game() {
-
-	//
-	// Check if there is something to free.
-	//
-	if (_blocks == NULL) {
-		log_debug_str("Already freed!");
-		return;
-	}
-
-	for (int i = 0; i < _home_num; i++) {
-		s_area_free(&_home_area[i].area);
-	}
-
-	blocks_free(_blocks, _blocks_dim.row);
-
-	//
-	// Mark as freed
-	//
-	_blocks = NULL;
-}
-
-/******************************************************************************
- * The function creates the home areas. It has to be called each time a game
- * starts.
- *****************************************************************************/
-
-void home_area_create_game(const s_game_cfg *game_cfg) {
-
-	//
-	// Ensure that the number of home areas is valid.
-	//
-	if (game_cfg->home_num > HOME_MAX) {
-		log_exit("Number of home areas too large: %d", game_cfg->home_num);
-	}
-
-	//
-	// Allocate the home areas.
-	//
-	_home_num = game_cfg->home_num;
-
-	for (int i = 0; i < _home_num; i++) {
-		log_debug("Creating area: %d", i);
-
-		s_area_create(&_home_area[i].area, &game_cfg->drop_dim, &game_cfg->home_size);
-	}
-
-	//
-	// Allocate backup storage.
-	//
-	s_point_set(&_blocks_dim, game_cfg->drop_dim.row, game_cfg->drop_dim.col);
-
-	_blocks = blocks_create(_blocks_dim.row, _blocks_dim.col);
-
-	//
-	// Reset / initialize the home area.
-	//
-	home_area_reset(game_cfg);
+	s_area_print_chess_pixel(cells, &engine->home[idx].area, pixel, block, da_color, home_area_get_chess_type(engine, idx));
 }
 
 /******************************************************************************
@@ -530,16 +277,16 @@ void home_area_create_game(const s_game_cfg *game_cfg) {
  * (horizontal / vertical).
  *****************************************************************************/
 
-s_point home_area_get_size(const bool horizontal) {
+s_point home_area_get_size(const s_engine *engine, const bool horizontal) {
 	s_point result;
 
 	if (horizontal) {
-		result.row = _home_area[0].area.dim.row * _home_area[0].area.size.row;
-		result.col = _home_num * (_home_area[0].area.dim.col * _home_area[0].area.size.col) + _home_area[0].area.size.col * (_home_num - 1);
+		result.row = engine->home[0].area.dim.row * engine->home[0].area.size.row;
+		result.col = engine->home_num * (engine->home[0].area.dim.col * engine->home[0].area.size.col) + engine->home[0].area.size.col * (engine->home_num - 1);
 
 	} else {
-		result.row = _home_num * (_home_area[0].area.dim.row * _home_area[0].area.size.row) + _home_area[0].area.size.row * (_home_num - 1);
-		result.col = _home_area[0].area.dim.col * _home_area[0].area.size.col;
+		result.row = engine->home_num * (engine->home[0].area.dim.row * engine->home[0].area.size.row) + engine->home[0].area.size.row * (engine->home_num - 1);
+		result.col = engine->home[0].area.dim.col * engine->home[0].area.size.col;
 
 	}
 
@@ -551,20 +298,20 @@ s_point home_area_get_size(const bool horizontal) {
  * the upper left position of all home areas and the layout.
  *****************************************************************************/
 
-void home_area_layout(const s_point *pos, const bool horizontal) {
+void home_area_layout(s_engine *engine, const s_point *pos, const bool horizontal) {
 
-	for (int i = 0; i < _home_num; i++) {
+	for (int i = 0; i < engine->home_num; i++) {
 
 		if (horizontal) {
-			_home_area[i].area.pos.row = pos->row;
-			_home_area[i].area.pos.col = pos->col + (_home_area[i].area.dim.col * _home_area[i].area.size.col) * i + _home_area[i].area.size.col * i;
+			engine->home[i].area.pos.row = pos->row;
+			engine->home[i].area.pos.col = pos->col + (engine->home[i].area.dim.col * engine->home[i].area.size.col) * i + engine->home[i].area.size.col * i;
 
 		} else {
-			_home_area[i].area.pos.row = pos->row + (_home_area[i].area.dim.row * _home_area[i].area.size.row) * i + _home_area[i].area.size.row * i;
-			_home_area[i].area.pos.col = pos->col;
+			engine->home[i].area.pos.row = pos->row + (engine->home[i].area.dim.row * engine->home[i].area.size.row) * i + engine->home[i].area.size.row * i;
+			engine->home[i].area.pos.col = pos->col;
 		}
 
-		log_debug("home area: %d pos: %d/%d", i, _home_area[i].area.pos.row, _home_area[i].area.pos.col);
+		log_debug("home area: %d pos: %d/%d", i, engine->home[i].area.pos.row, engine->home[i].area.pos.col);
 	}
 }
 
@@ -574,15 +321,15 @@ void home_area_layout(const s_point *pos, const bool horizontal) {
  * home area is picked up, so there is no other unused home area.
  *****************************************************************************/
 
-bool home_area_next_unused(s_point *pos) {
+bool home_area_next_unused(const s_engine *engine, s_point *pos) {
 	int start, end;
 
 	//
 	// If no home area is not picked up, we check all home areas.
 	//
-	if (_pickup_idx == PICKUP_IDX_UNDEF) {
+	if (engine->pickup_idx == ENGINE_PICKUP_UNDEF) {
 		start = 0;
-		end = _home_num;
+		end = engine->home_num;
 
 	}
 
@@ -591,25 +338,25 @@ bool home_area_next_unused(s_point *pos) {
 	// start after the current.
 	//
 	else {
-		start = _pickup_idx + 1;
-		end = _pickup_idx + _home_num;
+		start = engine->pickup_idx + 1;
+		end = engine->pickup_idx + engine->home_num;
 	}
 
-	log_debug("start: %d end: %d num: %d pickup: %d", start, end, _home_num, _pickup_idx);
+	log_debug("start: %d end: %d num: %d pickup: %d", start, end, engine->home_num, engine->pickup_idx);
 
 	for (int idx, i = start; i < end; i++) {
 
 		//
 		// Ensure that the index is in range
 		//
-		idx = i % _home_num;
+		idx = i % engine->home_num;
 
 		//
 		//  If we found an unsused home area, we copy the position and return
 		// true.
 		//
-		if (!_home_area[idx].droped) {
-			s_point_copy(pos, &_home_area[idx].area.pos);
+		if (!engine->home[idx].droped) {
+			s_point_copy(pos, &engine->home[idx].area.pos);
 			return true;
 		}
 	}
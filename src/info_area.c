@@ -35,7 +35,7 @@
 // The info area is surrounded by a box. So the first and the last row are part
 // of the box.
 //
-#define L_ROWS 7
+#define L_ROWS 9
 
 //
 // The column size is the size of the title plus the box with a padding space.
@@ -70,11 +70,15 @@ static wchar_t _data[L_ROWS][L_COLS];
 
 #define IDX_STATUS 5
 
-#define IDX_BOTTOM 6
+#define IDX_SEED 6
+
+#define IDX_HINT 7
+
+#define IDX_BOTTOM 8
 
 #define INNER_START IDX_TITLE
 
-#define INNER_END IDX_STATUS
+#define INNER_END IDX_HINT
 
 /******************************************************************************
  * The format definitions for the lines.
@@ -92,6 +96,10 @@ static wchar_t _data[L_ROWS][L_COLS];
 
 #define FMT_END   L"+++ END +++"
 
+#define FMT_SEED  L"Seed      : %08x"
+
+#define FMT_HINT  L"Hint      : %6ls"
+
 /******************************************************************************
  * The variables contain the score informations.
  *****************************************************************************/
@@ -102,6 +110,14 @@ static int _cur_score = 0;
 
 static int _turn = 0;
 
+/******************************************************************************
+ * The state of the hint, which is searched in the background.
+ *****************************************************************************/
+
+static e_hint_state _hint_state = HINT_SEARCHING;
+
+static const wchar_t *_hint_str[] = { L"search", L"ready", L"none" };
+
 /******************************************************************************
  * The struct contains the absolute position of the info area.
  *****************************************************************************/
@@ -206,6 +222,20 @@ void info_area_init(const s_status *status) {
 	//
 	fmt_center(&_data[IDX_STATUS][2], size_inner_get(), U_EMPTY, FMT_TURN, _turn);
 	add_border(_data[IDX_STATUS], size_line_get(), U_VLINE, U_EMPTY);
+
+	//
+	// Seed of the game, which can be used to replay the game.
+	//
+	fmt_center(&_data[IDX_SEED][2], size_inner_get(), U_EMPTY, FMT_SEED, status->engine.seed);
+	add_border(_data[IDX_SEED], size_line_get(), U_VLINE, U_EMPTY);
+
+	//
+	// The hint of a new game is searched.
+	//
+	_hint_state = HINT_SEARCHING;
+
+	fmt_center(&_data[IDX_HINT][2], size_inner_get(), U_EMPTY, FMT_HINT, _hint_str[_hint_state]);
+	add_border(_data[IDX_HINT], size_line_get(), U_VLINE, U_EMPTY);
 }
 
 /******************************************************************************
@@ -213,7 +243,7 @@ void info_area_init(const s_status *status) {
  * high score may change.
  *****************************************************************************/
 
-static void info_area_print_score(WINDOW *win, const s_status *status) {
+static void info_area_print_score(s_cells *cells, const s_status *status) {
 
 	//
 	// High score
@@ -233,7 +263,7 @@ static void info_area_print_score(WINDOW *win, const s_status *status) {
 	fmt_center(&_data[IDX_STATUS][2], size_inner_get(), U_EMPTY, FMT_TURN, _turn);
 	add_border(_data[IDX_STATUS], size_line_get(), U_VLINE, U_EMPTY);
 
-	info_area_print(win, status);
+	info_area_print(cells, status);
 }
 
 /******************************************************************************
@@ -241,7 +271,7 @@ static void info_area_print_score(WINDOW *win, const s_status *status) {
  * updated info area has to be reprinted.
  *****************************************************************************/
 
-void info_area_update_score_turns(WINDOW *win, const s_status *status, const int add_2_score) {
+void info_area_update_score_turns(s_cells *cells, const s_status *status, const int add_2_score) {
 
 	_cur_score += add_2_score;
 
@@ -256,18 +286,39 @@ void info_area_update_score_turns(WINDOW *win, const s_status *status, const int
 
 	_turn++;
 
-	info_area_print_score(win, status);
+	info_area_print_score(cells, status);
 }
 
 /******************************************************************************
  * The function updates the turns.
  *****************************************************************************/
 
-void info_area_new_turn(WINDOW *win, const s_status *status) {
+void info_area_new_turn(s_cells *cells, const s_status *status) {
 
 	_turn++;
 
-	info_area_print_score(win, status);
+	info_area_print_score(cells, status);
+}
+
+/******************************************************************************
+ * The function updates the state of the hint. If the state changed, the line
+ * is printed and the function returns true.
+ *****************************************************************************/
+
+bool info_area_update_hint(s_cells *cells, const s_status *status, const e_hint_state state) {
+
+	if (state == _hint_state) {
+		return false;
+	}
+
+	_hint_state = state;
+
+	fmt_center(&_data[IDX_HINT][2], size_inner_get(), U_EMPTY, FMT_HINT, _hint_str[_hint_state]);
+	add_border(_data[IDX_HINT], size_line_get(), U_VLINE, U_EMPTY);
+
+	info_area_print(cells, status);
+
+	return true;
 }
 
 /******************************************************************************
@@ -285,7 +336,7 @@ void info_area_set_pos(const int row, const int col) {
  * The function prints an inner line.
  *****************************************************************************/
 
-static void info_area_print_inner(WINDOW *win, const s_status *status, const int idx) {
+static void info_area_print_inner(s_cells *cells, const s_status *status, const int idx) {
 	wchar_t tmp[size_inner_get()];
 
 	//
@@ -304,28 +355,26 @@ static void info_area_print_inner(WINDOW *win, const s_status *status, const int
 	// If the line is the status line and the game has ended, we use an other
 	// color.
 	//
-	if (idx == IDX_STATUS && s_status_is_end(status)) {
-		colors_normal_end_attr(win);
-	}
+	const attr_t attr = idx == IDX_STATUS && s_status_is_end(status) ? colors_end_attr() : colors_normal_attr(CLR_NONE);
 
-	mvwaddwstr(win, _pos.row + IDX_STATUS, _pos.col + 2, tmp);
+	cells_set_str(cells, _pos.row + IDX_STATUS, _pos.col + 2, tmp, attr);
 }
 
 /******************************************************************************
  * The function prints the info area at the absolute position.
  *****************************************************************************/
 
-void info_area_print(WINDOW *win, const s_status *status) {
+void info_area_print(s_cells *cells, const s_status *status) {
 
 	log_debug("row: %d col: %d", _pos.row, _pos.col);
 
-	colors_normal_set_attr(win, CLR_NONE);
+	const attr_t attr = colors_normal_attr(CLR_NONE);
 
 	//
 	// Print each line
 	//
 	for (int i = 0; i < L_ROWS; i++) {
-		mvwaddwstr(win, _pos.row + i, _pos.col, _data[i]);
+		cells_set_str(cells, _pos.row + i, _pos.col, _data[i], attr);
 	}
 
 	//
@@ -333,7 +382,7 @@ void info_area_print(WINDOW *win, const s_status *status) {
 	// formated in a different way.
 	//
 	if (s_status_is_end(status)) {
-		info_area_print_inner(win, status, IDX_STATUS);
+		info_area_print_inner(cells, status, IDX_STATUS);
 	}
 }
 
@@ -341,7 +390,7 @@ void info_area_print(WINDOW *win, const s_status *status) {
  * The function sets the inner status line in case of the end of the game.
  *****************************************************************************/
 
-void info_area_set_end(WINDOW *win, const s_status *status) {
+void info_area_set_end(s_cells *cells, const s_status *status) {
 
 	//
 	// It is assumed that the game is already marked as ended.
@@ -359,31 +408,7 @@ void info_area_set_end(WINDOW *win, const s_status *status) {
 	//
 	// Print the inner line.
 	//
-	info_area_print_inner(win, status, IDX_STATUS);
-}
-
-/******************************************************************************
- * The function checks whether a pixel (terminal character) is inside the info
- * area. The function uses the maximal area not the currently used.
- *****************************************************************************/
-
-bool info_area_contains(const s_point *pixel) {
-
-	//
-	// Upper left corner
-	//
-	if (pixel->row < _pos.row || pixel->col < _pos.col) {
-		return false;
-	}
-
-	//
-	// Lower right corner (The columns have a terminating '\0')
-	//
-	if (pixel->row >= _pos.row + L_ROWS || pixel->col >= _pos.col + L_COLS - 1) {
-		return false;
-	}
-
-	return true;
+	info_area_print_inner(cells, status, IDX_STATUS);
 }
 
 /******************************************************************************
@@ -391,14 +416,12 @@ bool info_area_contains(const s_point *pixel) {
  * pixel is inside the info area.
  *****************************************************************************/
 
-void info_area_print_pixel(WINDOW *win, const s_point *pixel, const t_block color) {
+void info_area_print_pixel(s_cells *cells, const s_point *pixel, const t_block color) {
 
 	const int row = pixel->row - _pos.row;
 	const int col = pixel->col - _pos.col;
 
 	const wchar_t c = _data[row][col] == L'\0' ? L' ' : _data[row][col];
 
-	colors_normal_set_attr(win, color);
-
-	mvwprintw(win, pixel->row, pixel->col, "%lc", c);
+	cells_set(cells, pixel->row, pixel->col, c, colors_normal_attr(color));
 }
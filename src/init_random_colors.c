@@ -23,31 +23,29 @@
  */
 
 #include "s_game_cfg.h"
-#include "colors.h"
 
 /******************************************************************************
- * The function initializes the _random value, which will be configured in the
- * game cfg file.
+ * The function initializes the random value of the game data, which will be
+ * configured in the game cfg file.
  *****************************************************************************/
 
-static int _random;
+void init_random_colors_setup(s_game_data *game_data, const char *data) {
+	game_data->random = str_2_int(data);
 
-void init_random_colors_setup(const char *data) {
-	_random = str_2_int(data);
-
-	if (_random < 1 || _random > 100) {
-		log_exit("Random value is invalid: %d (allowed: 1 - 100)", _random);
+	if (game_data->random < 1 || game_data->random > 100) {
+		log_exit("Random value is invalid: %d (allowed: 1 - 100)", game_data->random);
 	}
 
-	log_debug("Random: %d", _random);
+	log_debug("Random: %d", game_data->random);
 }
 
 /******************************************************************************
  * The function fills a block array with random colors. The function ensures
- * that the center block has a color.
+ * that the center block has a color. The normalized form of the blocks is
+ * computed from the blocks.
  *****************************************************************************/
 
-void init_random_colors(const s_game_cfg *game_cfg, t_block **blocks) {
+void init_random_colors(const s_game_cfg *game_cfg, const s_game_data *game_data, s_rng *rng, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim) {
 
 	//
 	// Get the center block coordinates.
@@ -60,7 +58,7 @@ void init_random_colors(const s_game_cfg *game_cfg, t_block **blocks) {
 	//
 	// Set the center color
 	//
-	blocks[row_center][row_center] = colors_random_color();
+	blocks_at(blocks, row_center, col_center) = colors_random_color(rng);
 
 	for (int row = 0; row < game_cfg->drop_dim.row; row++) {
 		for (int col = 0; col < game_cfg->drop_dim.col; col++) {
@@ -75,14 +73,18 @@ void init_random_colors(const s_game_cfg *game_cfg, t_block **blocks) {
 			//
 			// First check if a block should get a color.
 			//
-			if (rand() % 100 < _random) {
-				blocks[row][col] = CLR_NONE;
+			if (rng_int(rng, 100) < game_data->random) {
+				blocks_at(blocks, row, col) = CLR_NONE;
 
 			} else {
-				blocks[row][col] = colors_random_color();
+				blocks_at(blocks, row, col) = colors_random_color(rng);
 			}
 
-			log_debug("block: %d/%d color: %d", row, col, blocks[row][col]);
+			log_debug("block: %d/%d color: %d", row, col, blocks_at(blocks, row, col));
 		}
 	}
+
+	bitboard_from_blocks(norm, blocks, &game_cfg->drop_dim);
+
+	bitboard_normalize(norm, &game_cfg->drop_dim, norm_dim);
 }
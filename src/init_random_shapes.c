@@ -27,19 +27,15 @@
 #include <errno.h>
 
 #include "init_random_shapes.h"
-#include "colors.h"
 #include "file_system.h"
 
 /*******************************************************************************
- * Definition of a fixed size array with shape structures.
+ * Definition of the maximal number of shapes. The shapes are stored in the
+ * game data.
  ******************************************************************************/
 
 #define SHAPES_MAX 256
 
-static s_shape _shapes[SHAPES_MAX];
-
-static int _num_shapes;
-
 /*******************************************************************************
  * Definitions of characters for the reading and writing of the shape data.
  ******************************************************************************/
@@ -60,7 +56,7 @@ static int _num_shapes;
 
 #ifdef DEBUG
 
-static void s_shape_debug(const int idx) {
+static void s_shape_debug(const s_shape *shape) {
 	char str[SHAPE_DIM + 1];
 
 	//
@@ -68,7 +64,7 @@ static void s_shape_debug(const int idx) {
 	//
 	str[SHAPE_DIM] = '\0';
 
-	log_debug("idx: %d label: %d", idx, _shapes[idx].label);
+	log_debug("label: %d", shape->label);
 
 	for (int i = 0; i < SHAPE_DIM; i++) {
 
@@ -76,7 +72,7 @@ static void s_shape_debug(const int idx) {
 		// Create a line with the row of the shape.
 		//
 		for (int j = 0; j < SHAPE_DIM; j++) {
-			str[j] = _shapes[idx].blocks[i][j] == SHAPE_DEF ? SHAPE_WRITE_DEF : SHAPE_WRITE_UNDEF;
+			str[j] = shape->blocks[i][j] == SHAPE_DEF ? SHAPE_WRITE_DEF : SHAPE_WRITE_UNDEF;
 		}
 
 		log_debug(" %s", str);
@@ -89,19 +85,19 @@ static void s_shape_debug(const int idx) {
  * The function initializes a shape struct.
  ******************************************************************************/
 
-static void s_shape_init(const int idx) {
+static void s_shape_init(s_shape *shape) {
 
 	//
 	// Initialize the label
 	//
-	_shapes[idx].label = SHAPE_UNDEF;
+	shape->label = SHAPE_UNDEF;
 
 	//
 	// Initialize the blocks
 	//
 	for (int i = 0; i < SHAPE_DIM; i++) {
 		for (int j = 0; j < SHAPE_DIM; j++) {
-			_shapes[idx].blocks[i][j] = SHAPE_UNDEF;
+			shape->blocks[i][j] = SHAPE_UNDEF;
 		}
 	}
 }
@@ -111,7 +107,7 @@ static void s_shape_init(const int idx) {
  * initialized, because the line may be smaller than the dimension.
  ******************************************************************************/
 
-static void s_shape_add_line(const int idx_shape, const int idx_line, const char *line) {
+static void s_shape_add_line(s_shape *shape, const int idx_line, const char *line) {
 
 	log_debug("Adding line: '%s'", line);
 
@@ -127,7 +123,7 @@ static void s_shape_add_line(const int idx_shape, const int idx_line, const char
 	for (int i = 0; i < end; i++) {
 
 		if (line[i] == SHAPE_READ_DEF) {
-			_shapes[idx_shape].blocks[idx_line][i] = SHAPE_DEF;
+			shape->blocks[idx_line][i] = SHAPE_DEF;
 
 		} else if (line[i] != SHAPE_READ_UNDEF) {
 			log_exit("Invalid line: '%s'", line);
@@ -136,15 +132,64 @@ static void s_shape_add_line(const int idx_shape, const int idx_line, const char
 }
 
 /*******************************************************************************
- * The function is called after the blocks of the shape are copied.
+ * The function is called after the blocks of the shape are copied. It
+ * computes the normalized form of the shape.
  ******************************************************************************/
 
-static void s_shape_finish(const int idx) {
+static void s_shape_finish(s_shape *shape, const int idx) {
+
+	shape->label = idx;
+
+	//
+	// Compute the bounding box of the defined blocks.
+	//
+	s_point lr = { -1, -1 };
+	s_point_set(&shape->ul, SHAPE_DIM, SHAPE_DIM);
 
-	_shapes[idx].label = idx;
+	for (int i = 0; i < SHAPE_DIM; i++) {
+		for (int j = 0; j < SHAPE_DIM; j++) {
+
+			if (shape->blocks[i][j] == SHAPE_DEF) {
+				shape->ul.row = min(shape->ul.row, i);
+				shape->ul.col = min(shape->ul.col, j);
+				lr.row = max(lr.row, i);
+				lr.col = max(lr.col, j);
+			}
+		}
+	}
+
+	if (lr.row < 0) {
+		log_exit("Shape: %d has no blocks!", idx);
+	}
+
+	s_point_set(&shape->dim, lr.row - shape->ul.row + 1, lr.col - shape->ul.col + 1);
+
+	//
+	// Compute the row masks and the list of blocks.
+	//
+	shape->num_cells = 0;
+
+	for (int i = 0; i < SHAPE_DIM; i++) {
+		shape->mask[i] = 0;
+	}
+
+	for (int i = 0; i < shape->dim.row; i++) {
+		for (int j = 0; j < shape->dim.col; j++) {
+
+			if (shape->blocks[i + shape->ul.row][j + shape->ul.col] == SHAPE_DEF) {
+				shape->mask[i] |= bitboard_bit(j);
+
+				//
+				// The macro evaluates its first argument twice.
+				//
+				s_point_set(&shape->cells[shape->num_cells], i, j);
+				shape->num_cells++;
+			}
+		}
+	}
 
 #ifdef DEBUG
-	s_shape_debug(idx);
+	s_shape_debug(shape);
 #endif
 }
 
@@ -154,10 +199,12 @@ static void s_shape_finish(const int idx) {
 
 #define BUF_SIZE 1024
 
-static void s_shape_process(FILE *file, const char *path) {
+static void s_shape_process(s_game_data *game_data, FILE *file, const char *path) {
 	char line[1024];
 	int idx = -1;
-	_num_shapes = 0;
+
+	s_shape *shapes = game_data->shapes;
+	int num_shapes = 0;
 
 	//
 	// Read the file line by line.
@@ -194,7 +241,7 @@ static void s_shape_process(FILE *file, const char *path) {
 			//
 			if (idx >= 0) {
 				idx = -1;
-				s_shape_finish(_num_shapes - 1);
+				s_shape_finish(&shapes[num_shapes - 1], num_shapes - 1);
 			}
 			continue;
 		}
@@ -208,24 +255,24 @@ static void s_shape_process(FILE *file, const char *path) {
 			//
 			// Ensure that there is at least one shape unused.
 			//
-			if (_num_shapes >= SHAPES_MAX) {
+			if (num_shapes >= SHAPES_MAX) {
 				log_exit("Too many shapes - max: %d", SHAPES_MAX);
 			}
 
 			//
 			// Increase the number of shapes.
 			//
-			_num_shapes++;
+			num_shapes++;
 
 			//
 			// Initialize the shape.
 			//
-			s_shape_init(_num_shapes - 1);
+			s_shape_init(&shapes[num_shapes - 1]);
 		}
 
 		idx++;
 
-		s_shape_add_line(_num_shapes - 1, idx, line);
+		s_shape_add_line(&shapes[num_shapes - 1], idx, line);
 
 	}
 
@@ -234,15 +281,19 @@ static void s_shape_process(FILE *file, const char *path) {
 	// shape.
 	//
 	if (idx >= 0) {
-		s_shape_finish(_num_shapes - 1);
+		s_shape_finish(&shapes[num_shapes - 1], num_shapes - 1);
 	}
+
+	game_data->num_shapes = num_shapes;
 }
 
 /*******************************************************************************
- * The function read the content of the file and fills the shape structures.
+ * The function read the content of the file and fills the shape structures of
+ * the game data. The array of the shapes is allocated and has to be freed with
+ * the game data.
  ******************************************************************************/
 
-void init_random_shapes_read(const char *file_name) {
+void init_random_shapes_read(s_game_data *game_data, const char *file_name) {
 
 	//
 	// The function is called with the file name. We need the path of the file.
@@ -264,9 +315,11 @@ void init_random_shapes_read(const char *file_name) {
 	}
 
 	//
-	// Delegate the processing to a separate function.
+	// Allocate the shapes and delegate the processing to a separate function.
 	//
-	s_shape_process(file, path);
+	game_data->shapes = xmalloc(sizeof(s_shape) * SHAPES_MAX);
+
+	s_shape_process(game_data, file, path);
 
 	//
 	// Close the file and check for errors.
@@ -278,10 +331,12 @@ void init_random_shapes_read(const char *file_name) {
 
 /*******************************************************************************
  * The function copies a random shape to an area. The shape structure has a
- * fixed size / dimension. The target area may be smaller.
+ * fixed size / dimension. The target area may be smaller. The normalized form
+ * of the shape is copied to the norm bitboard, if the shape fits in the area.
+ * Otherwise it is computed from the clipped blocks.
  ******************************************************************************/
 
-void init_random_shapes(const s_game_cfg *game_cfg, t_block **blocks) {
+void init_random_shapes(const s_game_cfg *game_cfg, const s_game_data *game_data, s_rng *rng, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim) {
 
 	const s_point *dim = &game_cfg->drop_dim;
 
@@ -298,17 +353,43 @@ void init_random_shapes(const s_game_cfg *game_cfg, t_block **blocks) {
 	//
 	// Select a random shape.
 	//
-	const int idx = rand() % _num_shapes;
-	const s_shape *shape = &_shapes[idx];
+	const int idx = rng_int(rng, game_data->num_shapes);
+	const s_shape *shape = &game_data->shapes[idx];
 
 	log_debug("Selecting shape: %d", idx);
 
 	//
-	// Copy the shape.
+	// Copy the blocks of the shape.
 	//
-	for (int i = 0; i < dim->row; i++) {
-		for (int j = 0; j < dim->col; j++) {
-			blocks[i][j] = shape->blocks[i][j] == SHAPE_DEF ? game_cfg->color : CLR_NONE;
+	blocks_set(blocks, dim, CLR_NONE);
+
+	bool clipped = false;
+
+	for (int i = 0; i < shape->num_cells; i++) {
+		const int row = shape->ul.row + shape->cells[i].row;
+		const int col = shape->ul.col + shape->cells[i].col;
+
+		if (row < dim->row && col < dim->col) {
+			blocks_at(blocks, row, col) = game_cfg->color;
+		} else {
+			clipped = true;
 		}
 	}
+
+	//
+	// If the shape is clipped, the precomputed form cannot be used.
+	//
+	if (clipped) {
+		bitboard_from_blocks(norm, blocks, dim);
+		bitboard_normalize(norm, dim, norm_dim);
+		return;
+	}
+
+	bitboard_clear(norm);
+
+	for (int i = 0; i < shape->dim.row; i++) {
+		bitboard_row(norm, i)[0] = shape->mask[i];
+	}
+
+	s_point_copy(norm_dim, &shape->dim);
 }
@@ -0,0 +1,236 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+
+#include "loop.h"
+
+/******************************************************************************
+ * The indices of the file descriptors of the poll() call.
+ *****************************************************************************/
+
+#define IDX_INPUT 0
+
+#define IDX_TIMER 1
+
+#define IDX_SIGNAL 2
+
+#define IDX_WORKER 3
+
+#define IDX_NUM 4
+
+/******************************************************************************
+ * The function creates the loop. The signals for resizing and terminating
+ * are blocked and are received with the signalfd.
+ *****************************************************************************/
+
+void loop_create(s_loop *loop) {
+
+	sigemptyset(&loop->mask);
+	sigaddset(&loop->mask, SIGWINCH);
+	sigaddset(&loop->mask, SIGTERM);
+	sigaddset(&loop->mask, SIGHUP);
+
+	const int error = pthread_sigmask(SIG_BLOCK, &loop->mask, NULL);
+
+	if (error != 0) {
+		log_exit("Unable to block signals: %s", strerror(error));
+	}
+
+	loop->fd_signal = signalfd(-1, &loop->mask, SFD_NONBLOCK | SFD_CLOEXEC);
+
+	if (loop->fd_signal == -1) {
+		log_exit("Unable to create signalfd: %s", strerror(errno));
+	}
+
+	loop->fd_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (loop->fd_timer == -1) {
+		log_exit("Unable to create timerfd: %s", strerror(errno));
+	}
+}
+
+/******************************************************************************
+ * The function frees the loop and unblocks the signals.
+ *****************************************************************************/
+
+void loop_free(s_loop *loop) {
+
+	close(loop->fd_timer);
+
+	close(loop->fd_signal);
+
+	pthread_sigmask(SIG_UNBLOCK, &loop->mask, NULL);
+}
+
+/******************************************************************************
+ * The function blocks or unblocks the resize signal of the calling thread. A
+ * code that reads the input without the loop, like a menu, unblocks the
+ * signal, so ncurses handles it and reports KEY_RESIZE.
+ *****************************************************************************/
+
+void loop_block_resize(const s_loop *loop DEBUG_USED, const bool block) {
+	sigset_t mask;
+
+	log_debug("Block resize: %s signalfd: %d", bool_str(block), loop->fd_signal);
+
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGWINCH);
+
+	const int error = pthread_sigmask(block ? SIG_BLOCK : SIG_UNBLOCK, &mask, NULL);
+
+	if (error != 0) {
+		log_exit("Unable to change signal mask: %s", strerror(error));
+	}
+}
+
+/******************************************************************************
+ * The function sets the timer, which expires once after the timeout in
+ * milliseconds. A negative timeout disarms the timer.
+ *****************************************************************************/
+
+void loop_set_timer(const s_loop *loop, const int timeout) {
+	struct itimerspec spec = { 0 };
+
+	if (timeout >= 0) {
+		spec.it_value.tv_sec = timeout / 1000;
+		spec.it_value.tv_nsec = (timeout % 1000) * 1000000L;
+
+		//
+		// A value of 0 disarms the timer, so an expired deadline expires after
+		// a nanosecond.
+		//
+		if (timeout == 0) {
+			spec.it_value.tv_nsec = 1;
+		}
+	}
+
+	if (timerfd_settime(loop->fd_timer, 0, &spec, NULL) == -1) {
+		log_exit("Unable to set timer: %s", strerror(errno));
+	}
+}
+
+/******************************************************************************
+ * The function reads a counter of a timerfd or an eventfd, which resets it.
+ *****************************************************************************/
+
+static void loop_read_counter(const int fd) {
+	uint64_t count;
+
+	if (read(fd, &count, sizeof(count)) == -1 && errno != EAGAIN) {
+		log_exit("Unable to read counter: %s", strerror(errno));
+	}
+}
+
+/******************************************************************************
+ * The function reads the pending signals and returns the corresponding event
+ * flags.
+ *****************************************************************************/
+
+static int loop_read_signals(const int fd) {
+	struct signalfd_siginfo info;
+	int events = 0;
+
+	for (;;) {
+		const ssize_t size = read(fd, &info, sizeof(info));
+
+		if (size == -1 && errno == EAGAIN) {
+			break;
+		}
+
+		if (size != sizeof(info)) {
+			log_exit("Unable to read signal: %s", strerror(errno));
+		}
+
+		log_debug("Signal: %u", info.ssi_signo);
+
+		events |= info.ssi_signo == SIGWINCH ? LOOP_RESIZE : LOOP_TERM;
+	}
+
+	return events;
+}
+
+/******************************************************************************
+ * The function waits until at least one event occurs and returns the flags
+ * of the events. The file descriptor of the worker is an eventfd, which is
+ * ignored if it is negative.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int loop_wait(const s_loop *loop, const int fd_worker) {
+	struct pollfd fds[IDX_NUM];
+	int events = 0;
+
+	fds[IDX_INPUT].fd = STDIN_FILENO;
+	fds[IDX_TIMER].fd = loop->fd_timer;
+	fds[IDX_SIGNAL].fd = loop->fd_signal;
+	fds[IDX_WORKER].fd = fd_worker;
+
+	for (int i = 0; i < IDX_NUM; i++) {
+		fds[i].events = POLLIN;
+		fds[i].revents = 0;
+	}
+
+	while (poll(fds, IDX_NUM, -1) == -1) {
+
+		if (errno != EINTR) {
+			log_exit("Poll failed: %s", strerror(errno));
+		}
+	}
+
+	if (fds[IDX_INPUT].revents & POLLIN) {
+		events |= LOOP_INPUT;
+
+	} else if (fds[IDX_INPUT].revents & (POLLHUP | POLLERR)) {
+
+		//
+		// The terminal is closed.
+		//
+		events |= LOOP_TERM;
+	}
+
+	if (fds[IDX_TIMER].revents & POLLIN) {
+		loop_read_counter(loop->fd_timer);
+		events |= LOOP_TIMER;
+	}
+
+	if (fds[IDX_SIGNAL].revents & POLLIN) {
+		events |= loop_read_signals(loop->fd_signal);
+	}
+
+	if (fds[IDX_WORKER].revents & POLLIN) {
+		loop_read_counter(fd_worker);
+		events |= LOOP_WORKER;
+	}
+
+	log_debug("Events: %d", events);
+
+	return events;
+}
@@ -23,8 +23,8 @@
  */
 
 #include <ncurses.h>
-#include <time.h>
 #include <locale.h>
+#include <errno.h>
 #include <linux/limits.h>
 
 #include "s_game_cfg.h"
@@ -39,9 +39,49 @@
 #include "game.h"
 #include "win_menu.h"
 #include "file_system.h"
+#include "anim.h"
+#include "loop.h"
+#include "vterm.h"
 
 static s_status _status = { .game_cfg = NULL };
 
+static s_loop _loop;
+
+/******************************************************************************
+ * The seed of the games, that can be set with the --seed option. If the option
+ * is not set, each game gets a new seed.
+ *****************************************************************************/
+
+static bool _seed_fixed = false;
+
+static uint32_t _seed;
+
+/******************************************************************************
+ * The duration of a frame of the drop animation. The --no-anim option
+ * disables the animation, so drops are instant.
+ *****************************************************************************/
+
+static long _anim_delay = ANIM_DELAY_MS;
+
+/******************************************************************************
+ * The number of frames of the benchmark, that can be set with the --bench
+ * option. The benchmark renders to a virtual terminal with a fixed dimension,
+ * so no terminal is necessary. The drop area is picked up and moved over the
+ * screen, but never dropped, so the scores are unchanged.
+ *****************************************************************************/
+
+#define BENCH_ROWS 40
+
+#define BENCH_COLS 120
+
+#define BENCH_PICKUP 32
+
+static long _bench_frames = 0;
+
+static uint32_t get_seed() {
+	return _seed_fixed ? _seed : rng_new_seed();
+}
+
 /******************************************************************************
  * The exit callback function resets the terminal and frees the memory. This is
  * important if the program terminates after an error.
@@ -77,6 +117,8 @@ static void exit_callback() {
 	//
 	nzc_finish_curses();
 
+	loop_free(&_loop);
+
 	log_debug_str("Exit callback finished!");
 }
 
@@ -93,13 +135,6 @@ static void init() {
 		log_exit_str("Unable to set the locale.");
 	}
 
-	//
-	// Initializes random number generator. The function does not return a
-	// value.
-	//
-	time_t t;
-	srand((unsigned) time(&t));
-
 	//
 	// Initialize the standard ncurses stuff
 	//
@@ -126,6 +161,8 @@ static void init() {
 
 	game_init();
 
+	game_set_anim_delay(_anim_delay);
+
 	//
 	// Read the configuration file.
 	//
@@ -153,7 +190,7 @@ static void create_game(s_status *status, const bool free, const s_game_cfg *gam
 	//
 	// Create the game and the drop area based on the dimensions.
 	//
-	game_create_game(status);
+	game_create_game(status, get_seed());
 }
 
 /******************************************************************************
@@ -166,6 +203,12 @@ static void create_game(s_status *status, const bool free, const s_game_cfg *gam
 void show_menu(s_status *status, const bool show_continue) {
 	log_debug_str("Showing start menu");
 
+	//
+	// The menu reads the input without the event loop, so ncurses has to
+	// handle the resizing.
+	//
+	loop_block_resize(&_loop, false);
+
 	//
 	// If a game is running, we have to clear the window.
 	//
@@ -223,7 +266,7 @@ void show_menu(s_status *status, const bool show_continue) {
 		create_game(status, show_continue, s_game_cfg_get(idx - offset));
 
 		if (show_continue) {
-			game_reset(status);
+			game_reset(status, status->engine.seed);
 			game_do_center(status);
 		}
 	}
@@ -237,38 +280,56 @@ void show_menu(s_status *status, const bool show_continue) {
 	} else {
 		log_exit("Unknown index: %d", idx);
 	}
+
+	loop_block_resize(&_loop, true);
 }
 
+/******************************************************************************
+ * The mouse events with one of the buttons. All other events are movements,
+ * which only move a picked up drop area.
+ *****************************************************************************/
+
+#define MOUSE_BUTTONS (BUTTON1_PRESSED | BUTTON2_RELEASED | BUTTON3_RELEASED)
+
+#define mouse_is_motion(e) (!((e)->bstate & MOUSE_BUTTONS))
+
 /******************************************************************************
  * The function does the processing of the mouse event.
  *****************************************************************************/
 
-static void process_mouse_event(s_status *status) {
-	MEVENT event;
+static void process_mouse_event(s_status *status, const MEVENT *event) {
+
+	//
+	// During an animation, the movements of the mouse are ignored. A button
+	// event skips the rest of the animation.
+	//
+	if (game_anim_is_running()) {
 
-	if (getmouse(&event) != OK) {
+		if (mouse_is_motion(event)) {
+			return;
+		}
 
-		//
-		// Report the details of the mouse event.
-		//
-		log_exit("Unable to get mouse event! mask: %s coords: %d/%d/%d", bool_str(event.bstate == 0), event.x, event.y, event.z);
-		return;
+		game_anim_finish(status);
+
+		if (s_status_is_end(status)) {
+			return;
+		}
 	}
 
-	if ((event.bstate & BUTTON2_RELEASED) || (event.bstate & BUTTON3_RELEASED)) {
+	if ((event->bstate & BUTTON2_RELEASED) || (event->bstate & BUTTON3_RELEASED)) {
 
 		if (s_status_is_picked_up(status)) {
 			game_process_event_undo_pickup(status);
 		}
 
 	} else {
-		const s_point event_point = { event.y, event.x };
+		const s_point event_point = { event->y, event->x };
 
-		if (event.bstate & BUTTON1_PRESSED) {
+		if (event->bstate & BUTTON1_PRESSED) {
 
 			if (s_status_is_picked_up(status)) {
 
-				if (home_area_get_idx(&event_point) >= 0) {
+				if (home_area_get_idx(&status->engine, &event_point) >= 0) {
 					game_process_event_undo_pickup(status);
 				} else {
 					game_event_drop(status);
@@ -287,116 +348,343 @@ static void process_mouse_event(s_status *status) {
 }
 
 /******************************************************************************
- * The main function.
+ * The function runs the benchmark with the first game of the configuration.
+ * The first frame writes all cells, so it is not part of the statistics.
  *****************************************************************************/
 
-int main() {
+static void bench(s_status *status, const long frames) {
+	s_vterm vterm;
 
-	log_debug_str("Starting nuzzle...");
+	colors_init_virtual();
 
-	init();
+	vterm_create(&vterm, BENCH_ROWS, BENCH_COLS);
 
-	show_menu(&_status, false);
+	game_init_vterm(&vterm);
+
+	game_set_anim_delay(0);
+
+	s_game_cfg_read(NUZZLE_CFG_FILE);
+
+	create_game(status, false, s_game_cfg_get(0));
 
 	//
-	// Without the refresh() the centered window will not be printed.
+	// The worker of the hint searches on an other core, which would disturb
+	// the measurement, so it is stopped. The benchmark never drops, so no
+	// hint is requested afterwards.
 	//
-	nzc_win_refresh(stdscr);
+	hint_free(&status->hint);
 
-	game_do_center(&_status);
+	game_do_center(status);
 
-	game_win_refresh();
+	game_win_refresh(status);
 
-	for (;;) {
-		int c = wgetch(stdscr);
+	const s_vterm_stats first = vterm.stats;
+
+	const double start = get_time();
+
+	for (long i = 0; i < frames; i++) {
 
 		//
-		// Exit with 'q'
+		// Switch the picked up home area from time to time, which prints
+		// the home areas to the layer.
 		//
-		if (c == 'q') {
-			break;
+		if (i % BENCH_PICKUP == 0) {
+			game_event_next_home_area(status);
 		}
 
-		if (c == ERR) {
-			log_debug_str("Nothing happened.");
-			continue;
-		}
+		const s_point pos = { (i * 3) % BENCH_ROWS, (i * 7) % BENCH_COLS };
 
-		if (c == KEY_RESIZE) {
+		game_event_move(status, &pos);
 
-			//
-			// Without the refresh() the centered window will not be printed.
-			//
-			nzc_win_refresh(stdscr);
+		game_win_refresh(status);
+	}
 
-			game_do_center(&_status);
+	const double time = get_time() - start;
 
-		} else if (c == KEY_ESC || c == 'm') {
+	const double num = frames > 0 ? frames : 1;
 
-			show_menu(&_status, true);
+	printf("Game        : %s\n", status->game_cfg->title);
+	printf("Frames      : %ld\n", frames);
+	printf("Frames/sec  : %.1f\n", time > 0 ? frames / time : 0);
+	printf("First frame : %ld bytes\n", first.bytes);
+	printf("Bytes/frame : %.1f\n", (vterm.stats.bytes - first.bytes) / num);
+	printf("Cells/frame : %.1f\n", (vterm.stats.cells - first.cells) / num);
+	printf("Attrs/frame : %.1f\n", (vterm.stats.attr_changes - first.attr_changes) / num);
 
-		} else {
+	game_free_game(status);
 
-			if (s_status_is_end(&_status)) {
-				log_debug_str("Ignoring key event due to current game end!");
-				continue;
+	game_free();
+
+	vterm_free(&vterm);
+}
+
+/******************************************************************************
+ * The function parses the command line arguments. The seed of the games makes
+ * the games reproducible. The seed can be given decimal or hexadecimal
+ * (0x...). The animation of the drops can be disabled. The benchmark is run
+ * instead of the game.
+ *****************************************************************************/
+
+static void parse_args(const int argc, char *argv[]) {
+
+	for (int i = 1; i < argc; i++) {
+
+		if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			char *tmp;
+
+			errno = 0;
+
+			const unsigned long seed = strtoul(argv[++i], &tmp, 0);
+
+			if (errno != 0 || *tmp != '\0' || seed > UINT32_MAX) {
+				log_exit("Invalid seed: %s", argv[i]);
+			}
+
+			_seed = (uint32_t) seed;
+			_seed_fixed = true;
+
+		} else if (strcmp(argv[i], "--no-anim") == 0) {
+			_anim_delay = 0;
+
+		} else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+			char *tmp;
+
+			_bench_frames = strtol(argv[++i], &tmp, 10);
+
+			if (*tmp != '\0' || _bench_frames <= 0) {
+				log_exit("Invalid number of frames: %s", argv[i]);
 			}
 
-			switch (c) {
+		} else {
+			log_exit("Usage: %s [--seed <seed>] [--no-anim] [--bench <frames>]", argv[0]);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function processes a key, which was read from the terminal. Mouse
+ * events and the resizing of the terminal are reported as keys. For a mouse
+ * event, the event struct contains the details.
+ *****************************************************************************/
+
+static void process_key(s_status *status, const int c, const MEVENT *event) {
+
+	//
+	// A key event skips the rest of a running animation, before it is
+	// processed. The space key only skips the animation.
+	//
+	if (c != KEY_MOUSE && game_anim_is_running()) {
+		game_anim_finish(status);
+
+		if (c == ' ') {
+			return;
+		}
+	}
+
+	if (c == KEY_RESIZE) {
+
+		//
+		// Without the refresh() the centered window will not be printed.
+		//
+		nzc_win_refresh(stdscr);
+
+		game_do_center(status);
+
+	} else if (c == KEY_ESC || c == 'm') {
+
+		show_menu(status, true);
+
+	} else {
+
+		if (s_status_is_end(status)) {
+			log_debug_str("Ignoring key event due to current game end!");
+			return;
+		}
+
+		switch (c) {
+
+		case KEY_MOUSE:
+			process_mouse_event(status, event);
+			break;
+
+		case KEY_UP:
+			game_event_keyboard_mv(status, -1, 0);
+			break;
+
+		case KEY_DOWN:
+			game_event_keyboard_mv(status, 1, 0);
+			break;
+
+		case KEY_LEFT:
+			game_event_keyboard_mv(status, 0, -1);
+			break;
 
-			case KEY_MOUSE:
-				process_mouse_event(&_status);
-				break;
+		case KEY_RIGHT:
+			game_event_keyboard_mv(status, 0, 1);
+			break;
+
+		case '\t':
+			game_event_next_home_area(status);
+			break;
+
+		case 'h':
+			game_event_hint(status);
+			break;
+
+		case 10:
+
+			//				//
+			//				// Try to drop the drop area on the game area. If the drop area
+			//				// was dropped, the home areas are refilled if necessary.
+			//				//
+			//				if (game_event_drop(status)) {
+			//
+			//					//
+			//					// If the drop area was dropped, then nothing is picked up.
+			//					// In this situation game_event_toggle_pickup() will pickup
+			//					// the next unused home area.
+			//					//
+			//					game_event_next_home_area(status);
+			//				}
+
+			game_event_drop(status);
+			break;
+
+		default:
+			log_debug("Pressed key %d (%s)", c, keyname(c));
+			return;
+		}
+	}
+}
+
+/******************************************************************************
+ * The function processes all keys, that are available, as a batch. The
+ * movements of the mouse are collapsed to the latest position, which is
+ * processed before the next other event or at the end of the batch. So a
+ * batch of movements moves the drop area once. The function returns true if
+ * an event was processed, so the window has to be refreshed once.
+ *****************************************************************************/
 
-			case KEY_UP:
-				game_event_keyboard_mv(&_status, -1, 0);
-				break;
+static bool process_input(s_status *status) {
+	MEVENT event;
+	MEVENT motion;
+	bool has_motion = false;
+	bool changed = false;
+	int c;
 
-			case KEY_DOWN:
-				game_event_keyboard_mv(&_status, 1, 0);
-				break;
+	wtimeout(stdscr, 0);
 
-			case KEY_LEFT:
-				game_event_keyboard_mv(&_status, 0, -1);
-				break;
+	while ((c = wgetch(stdscr)) != ERR) {
 
-			case KEY_RIGHT:
-				game_event_keyboard_mv(&_status, 0, 1);
-				break;
+		//
+		// Exit with 'q'
+		//
+		if (c == 'q') {
+			exit(EXIT_SUCCESS);
+		}
 
-			case '\t':
-				game_event_next_home_area(&_status);
-				break;
+		if (c == KEY_MOUSE) {
 
-			case 10:
+			if (getmouse(&event) != OK) {
 
-				//				//
-				//				// Try to drop the drop area on the game area. If the drop area
-				//				// was dropped, the home areas are refilled if necessary.
-				//				//
-				//				if (game_event_drop(&_status)) {
 				//
-				//					//
-				//					// If the drop area was dropped, then nothing is picked up.
-				//					// In this situation game_event_toggle_pickup() will pickup
-				//					// the next unused home area.
-				//					//
-				//					game_event_next_home_area(&_status);
-				//				}
-
-				game_event_drop(&_status);
-				break;
-
-			default:
-				log_debug("Pressed key %d (%s)", c, keyname(c));
+				// Report the details of the mouse event.
+				//
+				log_exit("Unable to get mouse event! mask: %s coords: %d/%d/%d", bool_str(event.bstate == 0), event.x, event.y, event.z);
+			}
+
+			if (mouse_is_motion(&event)) {
+				motion = event;
+				has_motion = true;
 				continue;
 			}
 		}
 
+		if (has_motion) {
+			process_key(status, KEY_MOUSE, &motion);
+			has_motion = false;
+		}
+
+		process_key(status, c, &event);
+		changed = true;
+	}
+
+	if (has_motion) {
+		process_key(status, KEY_MOUSE, &motion);
+		changed = true;
+	}
+
+	return changed;
+}
+
+/******************************************************************************
+ * The main function.
+ *****************************************************************************/
+
+int main(int argc, char *argv[]) {
+
+	log_debug_str("Starting nuzzle...");
+
+	parse_args(argc, argv);
+
+	if (_bench_frames > 0) {
+		bench(&_status, _bench_frames);
+		return EXIT_SUCCESS;
+	}
+
+	//
+	// The loop blocks the signals, so it has to be created before the
+	// threads of the hints are started.
+	//
+	loop_create(&_loop);
+
+	init();
+
+	show_menu(&_status, false);
+
+	//
+	// Without the refresh() the centered window will not be printed.
+	//
+	nzc_win_refresh(stdscr);
+
+	game_do_center(&_status);
+
+	game_win_refresh(&_status);
+
+	for (;;) {
+
+		//
+		// The timer is set to the deadline of the next frame. The loop sleeps
+		// until an event occurs.
+		//
+		loop_set_timer(&_loop, game_timeout());
+
+		const int events = loop_wait(&_loop, _status.hint.fd);
+
+		if (events & LOOP_TERM) {
+			log_debug_str("Terminated!");
+			exit(EXIT_SUCCESS);
+		}
+
+		if (events & LOOP_RESIZE) {
+			nzc_resize();
+		}
+
 		//
-		// Do a refresh
+		// Process all keys, that are available, which includes the KEY_RESIZE
+		// of the resizing. Then the frames of the drop animation, whose
+		// deadline is reached, are played and the state of the hint is
+		// shown. The window is refreshed once for all changes.
 		//
-		game_win_refresh();
+		bool changed = process_input(&_status);
+
+		changed |= game_anim_tick(&_status);
+
+		changed |= game_hint_update(&_status);
+
+		if (changed) {
+			game_win_refresh(&_status);
+		}
 	}
 
 	exit(EXIT_SUCCESS);
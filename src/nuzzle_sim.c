@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "sim.h"
+#include "file_system.h"
+
+/******************************************************************************
+ * The options of the simulation, with their default values. If no seed is
+ * given, a new seed is used. The game i is played with the seed + i.
+ *****************************************************************************/
+
+static int _game_idx = 0;
+
+static int _num_games = 1000;
+
+static s_sim_opts _opts = { .policy = SIM_POLICY_GREEDY, .beam = SOLVER_BEAM_DEFAULT, .expect = false };
+
+static bool _seed_fixed = false;
+
+static uint32_t _seed;
+
+static int _max_turns = 0;
+
+//
+// The number of worker threads. The default is the number of cores.
+//
+static int _num_threads = 0;
+
+/******************************************************************************
+ * The function parses a non negative number of an option. The program
+ * terminates if the number is not valid.
+ *****************************************************************************/
+
+static unsigned long parse_num(const char *str, const unsigned long max) {
+	char *tmp;
+
+	errno = 0;
+
+	const unsigned long num = strtoul(str, &tmp, 0);
+
+	if (errno != 0 || *tmp != '\0' || *str == '-' || num > max) {
+		log_exit("Invalid number: %s", str);
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The function returns the index of the game with the given title or index.
+ *****************************************************************************/
+
+static int parse_game(const char *str) {
+
+	for (int i = 0; i < s_game_cfg_num; i++) {
+
+		if (strcmp(str, s_game_cfg_get(i)->title) == 0) {
+			return i;
+		}
+	}
+
+	const int idx = (int) parse_num(str, INT_MAX);
+
+	if (idx >= s_game_cfg_num) {
+		log_exit("Unknown game: %s", str);
+	}
+
+	return idx;
+}
+
+/******************************************************************************
+ * The function prints the usage and terminates the program.
+ *****************************************************************************/
+
+static void usage(const char *name) {
+
+	fprintf(stderr, "Usage: %s [options]\n\n", name);
+	fprintf(stderr, "  --game <index|title>   : The game of the configuration. (default: 0)\n");
+	fprintf(stderr, "  --games <num>          : The number of games. (default: 1000)\n");
+	fprintf(stderr, "  --policy <policy>      : random, first-fit, greedy, eval or solver. (default: greedy)\n");
+	fprintf(stderr, "  --beam <num>           : The beam width of the solver. (default: %d)\n", SOLVER_BEAM_DEFAULT);
+	fprintf(stderr, "  --expect               : The solver adds the expected value of the next refill.\n");
+	fprintf(stderr, "  --seed <seed>          : The seed of the first game.\n");
+	fprintf(stderr, "  --max-turns <num>      : The maximum number of turns of a game. (default: 0 = unlimited)\n");
+	fprintf(stderr, "  --threads <num>        : The number of threads. (default: number of cores)\n");
+	fprintf(stderr, "  --list                 : Lists the games of the configuration.\n");
+
+	exit(EXIT_FAILURE);
+}
+
+/******************************************************************************
+ * The function parses the command line arguments. The configuration has to
+ * be read, because games can be given by their title.
+ *****************************************************************************/
+
+static void parse_args(const int argc, char *argv[]) {
+
+	for (int i = 1; i < argc; i++) {
+
+		if (strcmp(argv[i], "--list") == 0) {
+
+			for (int j = 0; j < s_game_cfg_num; j++) {
+				printf("%d: %s\n", j, s_game_cfg_get(j)->title);
+			}
+
+			exit(EXIT_SUCCESS);
+		}
+
+		if (strcmp(argv[i], "--expect") == 0) {
+			_opts.expect = true;
+			continue;
+		}
+
+		if (i + 1 >= argc) {
+			usage(argv[0]);
+		}
+
+		if (strcmp(argv[i], "--game") == 0) {
+			_game_idx = parse_game(argv[++i]);
+
+		} else if (strcmp(argv[i], "--games") == 0) {
+			_num_games = (int) parse_num(argv[++i], INT_MAX);
+
+		} else if (strcmp(argv[i], "--policy") == 0) {
+			_opts.policy = sim_policy_parse(argv[++i]);
+
+		} else if (strcmp(argv[i], "--beam") == 0) {
+			_opts.beam = (int) parse_num(argv[++i], INT_MAX);
+
+		} else if (strcmp(argv[i], "--seed") == 0) {
+			_seed = (uint32_t) parse_num(argv[++i], UINT32_MAX);
+			_seed_fixed = true;
+
+		} else if (strcmp(argv[i], "--max-turns") == 0) {
+			_max_turns = (int) parse_num(argv[++i], INT_MAX);
+
+		} else if (strcmp(argv[i], "--threads") == 0) {
+			_num_threads = (int) parse_num(argv[++i], INT_MAX);
+
+		} else {
+			usage(argv[0]);
+		}
+	}
+}
+
+/******************************************************************************
+ * The main function of the simulation. It plays the games of a configuration
+ * without a terminal and prints the statistics.
+ *****************************************************************************/
+
+int main(int argc, char *argv[]) {
+	s_sim_stats stats;
+
+	s_game_cfg_read(NUZZLE_CFG_FILE);
+
+	parse_args(argc, argv);
+
+	if (!_seed_fixed) {
+		_seed = rng_new_seed();
+	}
+
+	if (_num_threads <= 0) {
+		_num_threads = (int) max(1, sysconf(_SC_NPROCESSORS_ONLN));
+	}
+
+	const s_game_cfg *game_cfg = s_game_cfg_get(_game_idx);
+
+	printf("Game       : %s\n", game_cfg->title);
+	printf("Policy     : %s\n", sim_policy_str(_opts.policy));
+	printf("Seed       : %08x\n", _seed);
+	printf("Threads    : %d\n", _num_threads);
+
+	sim_stats_create(&stats, _num_games);
+
+	const double start = get_time();
+
+	sim_run(game_cfg, &_opts, _seed, _max_turns, _num_threads, &stats);
+
+	sim_stats_print(stdout, &stats, get_time() - start);
+
+	sim_stats_free(&stats);
+
+	return EXIT_SUCCESS;
+}
@@ -24,6 +24,9 @@
 
 #include <ncurses.h>
 #include <menu.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
 
 #include "common.h"
 
@@ -183,6 +186,26 @@ void nzc_win_refresh(WINDOW *win) {
 	}
 }
 
+/******************************************************************************
+ * The function resizes the terminal after a SIGWINCH signal, that was not
+ * handled by ncurses. The new size is read from the terminal. ncurses adds a
+ * KEY_RESIZE to the input, so the resizing is processed like a key.
+ *****************************************************************************/
+
+void nzc_resize() {
+	struct winsize ws;
+
+	if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == -1) {
+		log_exit("Unable to get terminal size: %s", strerror(errno));
+	}
+
+	log_debug("New size: %d/%d", ws.ws_row, ws.ws_col);
+
+	if (resizeterm(ws.ws_row, ws.ws_col) == ERR) {
+		log_exit_str("Unable to resize the terminal!");
+	}
+}
+
 /******************************************************************************
  * The function checks whether a row / column is inside a window or not.
  *****************************************************************************/
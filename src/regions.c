@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "regions.h"
+
+/******************************************************************************
+ * The region of the pixels outside the map, which is the background.
+ *****************************************************************************/
+
+static const s_region _region_bg = { .type = REGION_BG, .idx = -1, .block = { 0, 0 } };
+
+#define regions_is_inside(r,p) ((p)->row >= 0 && (p)->row < (r)->dim.row && (p)->col >= 0 && (p)->col < (r)->dim.col)
+
+#define regions_ptr(r,i,j) (&(r)->map[(i) * (r)->dim.col + (j)])
+
+/******************************************************************************
+ * The function frees the region map.
+ *****************************************************************************/
+
+void regions_free(s_regions *regions) {
+
+	free(regions->map);
+	regions->map = NULL;
+
+	s_point_set(&regions->dim, 0, 0);
+}
+
+/******************************************************************************
+ * The function resets the region map for a window with the given dimension.
+ * The map is reallocated, if the dimension changed. After the reset, all
+ * pixels are background pixels.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void regions_reset(s_regions *regions, const s_point *dim) {
+
+	if (regions->map == NULL || !s_point_same(&regions->dim, dim)) {
+		log_debug("Resize regions: %d/%d", dim->row, dim->col);
+
+		regions_free(regions);
+
+		s_point_set(&regions->dim, dim->row, dim->col);
+
+		//
+		// A window may have a size of 0, so we allocate at least one region.
+		//
+		const int num = dim->row * dim->col;
+		regions->map = xmalloc(sizeof(s_region) * (num > 0 ? num : 1));
+	}
+
+	const int num = regions->dim.row * regions->dim.col;
+
+	for (int i = 0; i < num; i++) {
+		regions->map[i] = _region_bg;
+	}
+}
+
+/******************************************************************************
+ * The function sets the region of the pixels of a rectangle. Pixels outside
+ * the map are ignored.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void regions_add_rect(s_regions *regions, const e_region_type type, const s_point *pos, const s_point *size) {
+	s_point pixel;
+
+	for (pixel.row = pos->row; pixel.row < pos->row + size->row; pixel.row++) {
+		for (pixel.col = pos->col; pixel.col < pos->col + size->col; pixel.col++) {
+
+			if (!regions_is_inside(regions, &pixel)) {
+				continue;
+			}
+
+			s_region *region = regions_ptr(regions, pixel.row, pixel.col);
+
+			region->type = type;
+			region->idx = -1;
+			s_point_set(&region->block, 0, 0);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function sets the region of the pixels of an area. Each pixel gets the
+ * block, that contains it. The index is the index of the home area or -1.
+ * Pixels outside the map are ignored.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void regions_add_area(s_regions *regions, const e_region_type type, const int idx, const s_area *area) {
+	s_point block;
+	s_point pixel;
+
+	for (block.row = 0; block.row < area->dim.row; block.row++) {
+		for (block.col = 0; block.col < area->dim.col; block.col++) {
+
+			//
+			// Get the absolute upper left pixel of the block.
+			//
+			const s_point ul = s_area_get_ul(area, &block);
+
+			for (pixel.row = ul.row; pixel.row < ul.row + area->size.row; pixel.row++) {
+				for (pixel.col = ul.col; pixel.col < ul.col + area->size.col; pixel.col++) {
+
+					if (!regions_is_inside(regions, &pixel)) {
+						continue;
+					}
+
+					s_region *region = regions_ptr(regions, pixel.row, pixel.col);
+
+					region->type = type;
+					region->idx = idx;
+					s_point_set(&region->block, block.row, block.col);
+				}
+			}
+		}
+	}
+}
+
+/******************************************************************************
+ * The function returns the region of a pixel. Pixels outside the map are
+ * background pixels.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+const s_region* regions_get(const s_regions *regions, const s_point *pixel) {
+
+	if (!regions_is_inside(regions, pixel)) {
+		return &_region_bg;
+	}
+
+	return regions_ptr(regions, pixel->row, pixel->col);
+}
@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "render.h"
+#include "nz_curses.h"
+
+/******************************************************************************
+ * The function writes a run of cells to an ncurses window with one bulk call.
+ *****************************************************************************/
+
+static void render_curses_put(void *target, const int row, const int col, const s_cell *cells, const int num) {
+	cchar_t buf[num];
+	wchar_t wch[2] = { L'\0', L'\0' };
+
+	for (int i = 0; i < num; i++) {
+
+		//
+		// Neighboring cells often have the same appearance, for example the
+		// blocks of an area, so the complex character is reused.
+		//
+		if (i > 0 && cells[i].chr == cells[i - 1].chr && cells[i].attr == cells[i - 1].attr) {
+			buf[i] = buf[i - 1];
+			continue;
+		}
+
+		wch[0] = cells[i].chr;
+
+		if (setcchar(&buf[i], wch, cells[i].attr & ~A_COLOR, PAIR_NUMBER(cells[i].attr), NULL) == ERR) {
+			log_exit("Unable to set char: %lc", cells[i].chr);
+		}
+	}
+
+	//
+	// The function does not wrap and ignores cells outside the window.
+	//
+	mvwadd_wchnstr((WINDOW*) target, row, col, buf, num);
+}
+
+/******************************************************************************
+ * The function refreshes the ncurses window.
+ *****************************************************************************/
+
+static void render_curses_show(void *target) {
+	WINDOW *win = (WINDOW*) target;
+
+	//
+	// Move the cursor to a save place and do the refreshing. If the cursor
+	// is not moved a flickering can occur. (I am not sure if this is necessary
+	// for this game, but I had trouble with it in the past)
+	//
+	if (wmove(win, 0, 0) == ERR) {
+		log_exit_str("Unable to move the cursor!");
+	}
+
+	nzc_win_refresh(win);
+}
+
+/******************************************************************************
+ * The function returns the dimension of the ncurses window.
+ *****************************************************************************/
+
+static s_point render_curses_get_dim(const void *target) {
+	WINDOW *win = (WINDOW*) target;
+
+	const s_point dim = { getmaxy(win), getmaxx(win) };
+
+	return dim;
+}
+
+/******************************************************************************
+ * The functions of the virtual terminal backend.
+ *****************************************************************************/
+
+static void render_vterm_put(void *target, const int row, const int col, const s_cell *cells, const int num) {
+	vterm_put((s_vterm*) target, row, col, cells, num);
+}
+
+static void render_vterm_show(void *target) {
+	vterm_show((s_vterm*) target);
+}
+
+static s_point render_vterm_get_dim(const void *target) {
+	return ((const s_vterm*) target)->dim;
+}
+
+/******************************************************************************
+ * The definition of the backends.
+ *****************************************************************************/
+
+static const s_render_ops _render_curses_ops = {
+
+	.name = "curses",
+
+	.put = render_curses_put,
+
+	.show = render_curses_show,
+
+	.get_dim = render_curses_get_dim,
+};
+
+static const s_render_ops _render_vterm_ops = {
+
+	.name = "vterm",
+
+	.put = render_vterm_put,
+
+	.show = render_vterm_show,
+
+	.get_dim = render_vterm_get_dim,
+};
+
+/******************************************************************************
+ * The function initializes a render struct with the ncurses backend, which
+ * writes to a window.
+ *****************************************************************************/
+
+void render_curses(s_render *render, WINDOW *win) {
+
+	render->ops = &_render_curses_ops;
+
+	render->target = win;
+
+	log_debug("Render backend: %s", render->ops->name);
+}
+
+/******************************************************************************
+ * The function initializes a render struct with the virtual terminal backend.
+ *****************************************************************************/
+
+void render_vterm(s_render *render, s_vterm *vterm) {
+
+	render->ops = &_render_vterm_ops;
+
+	render->target = vterm;
+
+	log_debug("Render backend: %s", render->ops->name);
+}
+
+/******************************************************************************
+ * The function flushes a cell buffer to the backend. It compares the buffer
+ * with the previous frame and only writes the runs of changed cells. The
+ * function returns the number of cells, that were written.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int render_flush(s_render *render, s_cells *cells) {
+	int num = 0;
+
+	for (int row = 0; row < cells->dim.row; row++) {
+		int start = 0;
+		int end;
+
+		while (cells_next_run(cells, row, &start, &end)) {
+
+			render->ops->put(render->target, row, start, cells_get(cells, row, start), end - start);
+
+			num += end - start;
+
+			start = end;
+		}
+	}
+
+	memcpy(cells->prev, cells->cur, sizeof(s_cell) * cells->dim.row * cells->dim.col);
+
+	log_debug("Flushed cells: %d", num);
+
+	return num;
+}
@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <time.h>
+
+#include "rng.h"
+
+/******************************************************************************
+ * The function is the splitmix64 generator, which is used to compute the
+ * state of the xoshiro256** generator from the seed.
+ *****************************************************************************/
+
+static uint64_t rng_splitmix(uint64_t *x) {
+
+	uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+	return z ^ (z >> 31);
+}
+
+/******************************************************************************
+ * The function rotates a 64 bit value to the left.
+ *****************************************************************************/
+
+static inline uint64_t rng_rotl(const uint64_t x, const int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+/******************************************************************************
+ * The function initializes the generator with a seed. The same seed results
+ * in the same sequence of numbers.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void rng_seed(s_rng *rng, const uint32_t seed) {
+
+	uint64_t x = seed;
+
+	for (int i = 0; i < 4; i++) {
+		rng->state[i] = rng_splitmix(&x);
+	}
+
+	log_debug("Seed: %u", seed);
+}
+
+/******************************************************************************
+ * The function returns the next 64 bit random number.
+ *****************************************************************************/
+
+uint64_t rng_next(s_rng *rng) {
+	uint64_t *s = rng->state;
+
+	const uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+
+	const uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+
+	s[2] ^= t;
+
+	s[3] = rng_rotl(s[3], 45);
+
+	return result;
+}
+
+/******************************************************************************
+ * The function returns a random number between 0 and num - 1. The upper 32
+ * bits of the next number are scaled with a multiplication, which avoids the
+ * division of the modulo operator.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+int rng_int(s_rng *rng, const int num) {
+	return (int) (((rng_next(rng) >> 32) * (uint64_t) num) >> 32);
+}
+
+/******************************************************************************
+ * The function returns a new seed, which is computed from the current time.
+ * It is used if no seed is given.
+ *****************************************************************************/
+
+uint32_t rng_new_seed() {
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_REALTIME, &ts) == -1) {
+		log_exit_str("Unable to get the time!");
+	}
+
+	uint64_t x = (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+
+	return (uint32_t) rng_splitmix(&x);
+}
@@ -22,331 +22,439 @@
  * SOFTWARE.
  */
 
-#include "colors.h"
 #include "rules.h"
 
-//
-// The 2-dimensional array with temporary data.
-//
-static t_block **_marks = NULL;
-
 /******************************************************************************
- * The function creates an area which is used for markings. This has to be
+ * The function allocates the temporary data of the rules. This has to be
  * called every time a new game is started.
  *****************************************************************************/
 
-void rules_create_game(const s_area *area) {
+void rules_create_game(s_rules *rules, const s_area *area) {
+
+	log_debug_str("Creating rules data.");
+
+	const int num = area->dim.row * area->dim.col;
+
+	//
+	// The number of blocks is an upper bound for the number of squares.
+	//
+	rules->visited = xmalloc(sizeof(unsigned int) * num);
+	memset(rules->visited, 0, sizeof(unsigned int) * num);
+
+	rules->visited_squares = xmalloc(sizeof(unsigned int) * num);
+	memset(rules->visited_squares, 0, sizeof(unsigned int) * num);
+
+	rules->stamp = 0;
+
+	rules->footprint = xmalloc(sizeof(int) * num);
 
-	log_debug_str("Creating blocks.");
+	rules->component = xmalloc(sizeof(int) * num);
 
-	_marks = blocks_create(area->dim.row, area->dim.col);
+	rules->full_rows = xmalloc(sizeof(int) * area->dim.row);
+	rules->full_cols = xmalloc(sizeof(int) * area->dim.col);
+
+	rules->full_squares = xmalloc(sizeof(int) * num);
 }
 
 /******************************************************************************
- * The function frees an area which is used for markings. This has to be
- * called every time a new game ended.
+ * The function frees the temporary data of the rules. This has to be called
+ * every time a new game ended.
  *****************************************************************************/
 
-void rules_free_game(const s_area *area) {
+void rules_free_game(s_rules *rules) {
+
+	log_debug_str("Freeing rules data.");
+
+	free(rules->visited);
+	rules->visited = NULL;
+
+	free(rules->visited_squares);
+	rules->visited_squares = NULL;
 
-	log_debug_str("Freeing blocks.");
+	free(rules->footprint);
+	rules->footprint = NULL;
 
-	blocks_free(_marks, area->dim.row);
+	free(rules->component);
+	rules->component = NULL;
+
+	free(rules->full_rows);
+	rules->full_rows = NULL;
+
+	free(rules->full_cols);
+	rules->full_cols = NULL;
+
+	free(rules->full_squares);
+	rules->full_squares = NULL;
 }
 
 /******************************************************************************
- * The function marks horizontal and vertical lines.
+ * The function starts a new call of a rule, by changing the stamp. This
+ * invalidates all visits of the previous calls. If the stamp overflows, the
+ * visited arrays have to be reset.
  *****************************************************************************/
 
-static void rules_mark_lines(const s_area *area, t_block **marks) {
+static void rules_new_stamp(s_rules *rules, const s_area *area) {
+
+	if (++rules->stamp == 0) {
+		memset(rules->visited, 0, sizeof(unsigned int) * area->dim.row * area->dim.col);
+		memset(rules->visited_squares, 0, sizeof(unsigned int) * area->dim.row * area->dim.col);
+		rules->stamp = 1;
+	}
+}
 
-	bool is_complete;
+/******************************************************************************
+ * The function computes the footprint of the last drop. These are the blocks
+ * of the area, that were set by the drop, so only they can complete a line, a
+ * square or a component. The blocks are taken from the bitboard of the drop
+ * area, which is placed at the index. If the drop area is NULL, the footprint
+ * are all blocks of the area, that are set. The function returns the number
+ * of blocks of the footprint.
+ *****************************************************************************/
 
-	//
-	// Process rows.
-	//
-	for (int row = 0; row < area->dim.row; row++) {
+static int rules_footprint(s_rules *rules, const s_area *area, const s_area *drop_area, const s_point *idx) {
+	int num = 0;
 
-		is_complete = true;
+	if (drop_area == NULL) {
 
-		for (int col = 0; col < area->dim.col; col++) {
+		for (int row = 0; row < area->dim.row; row++) {
+			const t_block *ptr = blocks_row(&area->blocks, row);
 
-			if (area->blocks[row][col] == CLR_NONE) {
-				is_complete = false;
-				break;
+			for (int col = 0; col < area->dim.col; col++) {
+
+				if (ptr[col] != CLR_NONE) {
+					rules->footprint[num++] = row * area->dim.col + col;
+				}
 			}
 		}
 
-		if (is_complete) {
+	} else {
 
-			log_debug("Mark line at row: %d", row);
+		for (int row = 0; row < drop_area->dim.row; row++) {
 
-			for (int col = 0; col < area->dim.col; col++) {
-				marks[row][col] = RULES_MARKER;
+			//
+			// The rows of a drop area fit in a single word.
+			//
+			for (t_word mask = bitboard_row(&drop_area->bits, row)[0]; mask != 0; mask &= mask - 1) {
+				rules->footprint[num++] = (idx->row + row) * area->dim.col + idx->col + __builtin_ctzll(mask);
 			}
 		}
 	}
 
+	log_debug("Footprint blocks: %d", num);
+
+	return num;
+}
+
+/******************************************************************************
+ * The function collects the complete horizontal and vertical lines, that
+ * contain blocks of the last drop. A line is complete if its fill counter
+ * equals the length of the line, so only the counters of the rows and columns
+ * of the drop area are read. If the drop area is NULL, all lines are checked.
+ *****************************************************************************/
+
+static void rules_find_lines(s_rules *rules, const s_area *area, const s_area *drop_area, const s_point *idx, int *num_rows, int *num_cols) {
+
 	//
-	// Process columns.
+	// Without a drop area, all rows and columns are checked.
 	//
-	for (int col = 0; col < area->dim.col; col++) {
+	const s_point from = drop_area == NULL ? (s_point ) { 0, 0 } : *idx;
+	const s_point to = drop_area == NULL ? area->dim : (s_point ) { idx->row + drop_area->dim.row, idx->col + drop_area->dim.col };
 
-		is_complete = true;
+	*num_rows = 0;
 
-		for (int row = 0; row < area->dim.row; row++) {
+	for (int row = from.row; row < to.row; row++) {
 
-			if (area->blocks[row][col] == CLR_NONE) {
-				is_complete = false;
-				break;
-			}
+		//
+		// Skip the rows without blocks of the drop area.
+		//
+		if (drop_area != NULL && drop_area->row_fill[row - idx->row] == 0) {
+			continue;
 		}
 
-		if (is_complete) {
+		if (area->row_fill[row] == area->dim.col) {
+			log_debug("Found line at row: %d", row);
+			rules->full_rows[(*num_rows)++] = row;
+		}
+	}
 
-			log_debug("Mark line at col: %d", col);
+	*num_cols = 0;
 
-			for (int row = 0; row < area->dim.row; row++) {
-				marks[row][col] = RULES_MARKER;
-			}
+	for (int col = from.col; col < to.col; col++) {
+
+		//
+		// Skip the columns without blocks of the drop area.
+		//
+		if (drop_area != NULL && drop_area->col_fill[col - idx->col] == 0) {
+			continue;
+		}
+
+		if (area->col_fill[col] == area->dim.row) {
+			log_debug("Found line at col: %d", col);
+			rules->full_cols[(*num_cols)++] = col;
 		}
 	}
 }
 
 /******************************************************************************
- * The function checks if all blocks of a square (3x3) are set.
+ * The function removes the lines, that were found before, and returns the
+ * number of removed blocks. Blocks at the intersection of a row and a column
+ * are removed and counted only once.
  *****************************************************************************/
 
-static void rules_mark_square(const s_area *area, t_block **marks, const int start_row, const int start_col) {
+static int rules_remove_found_lines(const s_rules *rules, s_area *area, const int num_rows, const int num_cols) {
+	int count = 0;
 
-	//
-	// Compute the end of the squares
-	//
-	const int end_row = start_row + RULES_SQUARE_DIM;
-	const int end_col = start_col + RULES_SQUARE_DIM;
+	for (int i = 0; i < num_rows; i++) {
+		const int row = rules->full_rows[i];
+		const t_block *ptr = blocks_row(&area->blocks, row);
 
-	//
-	// Ensure that all blocks of the square are set.
-	//
-	for (int row = start_row; row < end_row; row++) {
-		for (int col = start_col; col < end_col; col++) {
+		for (int col = 0; col < area->dim.col; col++) {
 
-			//
-			// If we found a block that is not set, we do not need to check
-			// more.
-			//
-			if (area->blocks[row][col] == CLR_NONE) {
-				return;
+			if (ptr[col] != CLR_NONE) {
+				s_area_remove_block(area, row, col);
+				count++;
 			}
 		}
 	}
 
-	log_debug("Mark square at: %d/%d", start_row, start_col);
+	for (int i = 0; i < num_cols; i++) {
+		const int col = rules->full_cols[i];
 
-	//
-	// If all the blocks are set in the area, we can mark the square in the
-	// marks array.
-	//
-	for (int row = start_row; row < end_row; row++) {
-		for (int col = start_col; col < end_col; col++) {
-			marks[row][col] = RULES_MARKER;
+		for (int row = 0; row < area->dim.row; row++) {
+
+			if (s_area_block(area, row, col) != CLR_NONE) {
+				s_area_remove_block(area, row, col);
+				count++;
+			}
 		}
 	}
+
+	return count;
 }
 
 /******************************************************************************
- * The function checks the squares (3x3) in the area and marks squares that are
- * completely set.
+ * The function collects the complete squares, that contain blocks of the
+ * footprint. A square is complete if its fill counter equals the number of
+ * its blocks. Squares at the borders, that do not have the full dimension,
+ * are never complete.
  *****************************************************************************/
 
-static void rules_mark_squares(const s_area *area, t_block **marks) {
+static int rules_find_squares(s_rules *rules, const s_area *area, const int num_footprint) {
+	int num = 0;
+
+	const int full = area->square_dim * area->square_dim;
+
+	for (int i = 0; i < num_footprint; i++) {
+
+		const int square_row = area->square_row[rules->footprint[i] / area->dim.col];
+		const int square_col = area->square_col[rules->footprint[i] % area->dim.col];
+
+		if (square_row < 0 || square_col < 0) {
+			continue;
+		}
+
+		const int idx = s_area_square_idx(area, square_row, square_col);
+
+		//
+		// Each square is checked only once.
+		//
+		if (rules->visited_squares[idx] == rules->stamp) {
+			continue;
+		}
 
-	for (int row = 0; row < area->dim.row; row = row + RULES_SQUARE_DIM) {
-		for (int col = 0; col < area->dim.col; col = col + RULES_SQUARE_DIM) {
+		rules->visited_squares[idx] = rules->stamp;
 
-			rules_mark_square(area, marks, row, col);
+		if (area->square_fill[idx] == full) {
+			log_debug("Found square at: %d/%d", square_row, square_col);
+			rules->full_squares[num++] = idx;
 		}
 	}
+
+	return num;
 }
 
 /******************************************************************************
- * The function removes blocks from the area, which are marked in the marks
- * array and returns the number of blocks that were removed.
+ * The function removes the squares, that were found before, and returns the
+ * number of removed blocks.
  *****************************************************************************/
 
-static int rules_remove_marked(const s_area *area, t_block **marks) {
+static int rules_remove_found_squares(const s_rules *rules, s_area *area, const int num_squares) {
 	int count = 0;
 
-	for (int row = 0; row < area->dim.row; row++) {
-		for (int col = 0; col < area->dim.col; col++) {
+	for (int i = 0; i < num_squares; i++) {
 
-			//
-			// If the block is marked, we can remove it from the game.
-			//
-			if (marks[row][col] != CLR_NONE) {
-
-				area->blocks[row][col] = CLR_NONE;
+		const int start_row = (rules->full_squares[i] / area->square_num.col) * area->square_dim;
+		const int start_col = (rules->full_squares[i] % area->square_num.col) * area->square_dim;
 
+		for (int row = start_row; row < start_row + area->square_dim; row++) {
+			for (int col = start_col; col < start_col + area->square_dim; col++) {
+				s_area_remove_block(area, row, col);
 				count++;
 			}
 		}
 	}
 
-	log_debug("Removed: %d blocks.", count);
-
 	return count;
 }
 
 /******************************************************************************
- * The function resets the array with the marks.
+ * The function applies rules to the area. Horizontal and vertical lines are
+ * removed. The function returns the number of blacks that are removed.
+ *
+ * The drop area and the index define the footprint of the last drop. If the
+ * drop area is NULL, the whole area is checked.
  *****************************************************************************/
 
-static void rule_reset_marks(const s_area *area, t_block **marks) {
+int rules_remove_lines(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx) {
+	int num_rows, num_cols;
 
-	for (int row = 0; row < area->dim.row; row++) {
-		for (int col = 0; col < area->dim.col; col++) {
+	rules_find_lines(rules, area, drop_area, idx, &num_rows, &num_cols);
 
-			if (marks[row][col] != CLR_NONE) {
-				marks[row][col] = CLR_NONE;
-			}
-		}
-	}
+	return rules_remove_found_lines(rules, area, num_rows, num_cols);
 }
 
 /******************************************************************************
- * The function applies rules to the area. Horizontal and vertical lines are
- * removed. The function returns the number of blacks that are removed.
+ * The function applies rules to the area. Squares and horizontal and vertical
+ * lines are removed. The function returns the number of blacks that are
+ * removed. The area has to have squares (see: s_area_create_squares()).
  *****************************************************************************/
 
-int rules_remove_lines(const s_area *area) {
+int rules_remove_squares_lines(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx) {
+	int num_rows, num_cols;
+
+	rules_new_stamp(rules, area);
+
+	const int num_footprint = rules_footprint(rules, area, drop_area, idx);
 
-	rule_reset_marks(area, _marks);
+	//
+	// The lines and the squares have to be found before anything is removed.
+	//
+	rules_find_lines(rules, area, drop_area, idx, &num_rows, &num_cols);
 
-	rules_mark_lines(area, _marks);
+	const int num_squares = rules_find_squares(rules, area, num_footprint);
 
-	return rules_remove_marked(area, _marks);
+	const int count = rules_remove_found_squares(rules, area, num_squares);
+
+	return count + rules_remove_found_lines(rules, area, num_rows, num_cols);
 }
 
 /******************************************************************************
- * The function applies rules to the area. 3x3 squares and horizontal and
- * vertical lines are removed. The function returns the number of blacks that
- * are removed.
+ * The function adds a block to the current component, if it has the color of
+ * the component and was not visited before.
  *****************************************************************************/
 
-int rules_remove_squares_lines(const s_area *area) {
-
-	rule_reset_marks(area, _marks);
+static inline void rules_visit(s_rules *rules, const s_area *area, const int row, const int col, const t_block color, int *end) {
 
-	rules_mark_squares(area, _marks);
+	const int idx = row * area->dim.col + col;
 
-	rules_mark_lines(area, _marks);
+	if (rules->visited[idx] == rules->stamp || s_area_block(area, row, col) != color) {
+		return;
+	}
 
-	return rules_remove_marked(area, _marks);
+	rules->visited[idx] = rules->stamp;
+	rules->component[(*end)++] = idx;
 }
 
 /******************************************************************************
- * The function is called with a color and recursively marks all neighbors,
- * that have the same color. The recursion stops if all neighbors have
- * different colors or are already marked.
+ * The function collects the component of blocks with the same color, that
+ * contains the block at the given position. The blocks are stored in the
+ * component array, starting at the given index. The array is used as the
+ * queue of a breadth first search, so no recursion is necessary. The function
+ * returns the end index of the component.
  *****************************************************************************/
 
-static void rules_mark_neighbors(const s_area *area, t_block **marks, const int row, const int col, t_block color, int *num) {
+static int rules_collect_component(s_rules *rules, const s_area *area, const int row, const int col, const t_block color, const int start) {
+	int end = start;
 
-	//
-	// Ensure that we are on the game area. The function is called on the
-	// neighbors of a block by adding and subtracting 1 to the row / column.
-	//
-	if (row < 0 || row >= area->dim.row || col < 0 || col >= area->dim.row) {
-		log_debug("Outside: %d/%d num: %d color: %d", row, col, *num, color);
-		return;
-	}
+	rules_visit(rules, area, row, col, color, &end);
 
-	//
-	// Current block has the wrong color.
-	//
-	if (area->blocks[row][col] != color) {
-		log_debug("Wrong color: %d/%d num: %d color: %d", row, col, *num, color);
-		return;
-	}
+	for (int i = start; i < end; i++) {
 
-	//
-	// Current block is already marked.
-	//
-	if (marks[row][col] != 0) {
-		log_debug("Already marked: %d/%d num: %d color: %d", row, col, *num, color);
-		return;
-	}
+		const int cur_row = rules->component[i] / area->dim.col;
+		const int cur_col = rules->component[i] % area->dim.col;
 
-	//
-	// Increase the number and mark the block.
-	//
-	marks[row][col] = ++(*num);
+		//
+		// Ensure that we are on the game area, before the neighbors are
+		// visited.
+		//
+		if (cur_row + 1 < area->dim.row) {
+			rules_visit(rules, area, cur_row + 1, cur_col, color, &end);
+		}
 
-	log_debug("Mark: %d/%d num: %d color: %d", row, col, *num, color);
+		if (cur_row > 0) {
+			rules_visit(rules, area, cur_row - 1, cur_col, color, &end);
+		}
 
-	//
-	// Recursively process the neighbors.
-	//
-	rules_mark_neighbors(area, marks, row + 1, col, color, num);
-	rules_mark_neighbors(area, marks, row - 1, col, color, num);
-	rules_mark_neighbors(area, marks, row, col + 1, color, num);
-	rules_mark_neighbors(area, marks, row, col - 1, color, num);
+		if (cur_col + 1 < area->dim.col) {
+			rules_visit(rules, area, cur_row, cur_col + 1, color, &end);
+		}
+
+		if (cur_col > 0) {
+			rules_visit(rules, area, cur_row, cur_col - 1, color, &end);
+		}
+	}
+
+	log_debug("Component at: %d/%d color: %d size: %d", row, col, color, end - start);
+
+	return end;
 }
 
 /******************************************************************************
  * The function is called after an area is dropped. It checks if blocks of the
- * game area should disappear. If more than 4 blocks with the same color are
+ * game area should disappear. If 4 or more blocks with the same color are
  * neighbors, they should be removed.
  *
- * The function returns the number of removed blocks. If the total number is
- * less than 4, then nothing will be removed, so we return 0.
+ * The function labels the components of the footprint of the last drop in a
+ * single sweep. Each block is visited at most once, which is ensured by
+ * comparing the visited array with a stamp, that changes with each call. So
+ * the visited array has not to be reset.
+ *
+ * The function returns the number of removed blocks.
  *****************************************************************************/
-// TODO: mark already visited
-int rules_remove_neighbors(const s_area *area) {
+
+int rules_remove_neighbors(s_rules *rules, s_area *area, const s_area *drop_area, const s_point *idx) {
 	int total = 0;
-	int num;
 
-	t_block color;
+	rules_new_stamp(rules, area);
+
+	const int num_footprint = rules_footprint(rules, area, drop_area, idx);
 
 	//
-	// Iterate over the blocks of the drop area.
+	// Only the blocks of the footprint can be the trigger for a removing.
 	//
-	for (int row = 0; row < area->dim.row; row++) {
-		for (int col = 0; col < area->dim.col; col++) {
+	for (int i = 0; i < num_footprint; i++) {
 
-			color = area->blocks[row][col];
+		const int row = rules->footprint[i] / area->dim.col;
+		const int col = rules->footprint[i] % area->dim.col;
 
-			//
-			// If the current, dropped block of the area has no color, it
-			// cannot be the trigger for a removing.
-			//
-			if (color == CLR_NONE) {
-				log_debug("drop (used) empty: %d/%d", row, col);
-				continue;
-			}
+		//
+		// Each component is collected only once. If the block is part of a
+		// component, that was already collected, there is nothing to do.
+		//
+		if (rules->visited[rules->footprint[i]] == rules->stamp) {
+			continue;
+		}
 
-			//
-			// If the block of the dropped area has a color, we mark all
-			// neighbors with the same color.
-			//
-			num = 0;
-			rule_reset_marks(area, _marks);
-			rules_mark_neighbors(area, _marks, row, col, color, &num);
-			log_debug("num: %d", num);
+		//
+		// The blocks of the component are stored at the start of the array.
+		//
+		const int num = rules_collect_component(rules, area, row, col, s_area_block(area, row, col), 0);
 
-			//
-			// If the number of neighbors with the same color is more than
-			// 4, we have to remove the marks from the game area.
-			//
-			if (num >= 4) {
-				rules_remove_marked(area, _marks);
-				total += num;
+		//
+		// If the number of neighbors with the same color is 4 or more, we
+		// have to remove them from the game area.
+		//
+		if (num >= 4) {
+
+			for (int j = 0; j < num; j++) {
+				s_area_remove_block(area, rules->component[j] / area->dim.col, rules->component[j] % area->dim.col);
 			}
+
+			total += num;
 		}
 	}
 
-	//
-	// Return a positive number only if something was removed.
-	//
-	return total >= 4 ? total : 0;
+	log_debug("Removed: %d blocks.", total);
+
+	return total;
 }
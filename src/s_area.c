@@ -23,7 +23,6 @@
  */
 
 #include "s_area.h"
-#include "colors.h"
 
  /******************************************************************************
   * The function copies one area to an other. The blocks are shared.
@@ -35,6 +34,17 @@ void s_area_copy(const s_area *from, s_area *to) {
 
 	to->blocks = from->blocks;
 
+	to->bits = from->bits;
+
+	to->row_fill = from->row_fill;
+	to->col_fill = from->col_fill;
+
+	to->square_dim = from->square_dim;
+	s_point_copy(&to->square_num, &from->square_num);
+	to->square_row = from->square_row;
+	to->square_col = from->square_col;
+	to->square_fill = from->square_fill;
+
 	s_point_copy(&to->dim, &from->dim);
 	s_point_copy(&to->pos, &from->pos);
 	s_point_copy(&to->size, &from->size);
@@ -52,10 +62,19 @@ void s_area_copy_deep(const s_area *from, s_area *to) {
 	s_point_copy(&to->pos, &from->pos);
 	s_point_copy(&to->size, &from->size);
 
-	for (int i = 0; i < from->dim.row; i++) {
-		for (int j = 0; j < from->dim.col; j++) {
-			to->blocks[i][j] = from->blocks[i][j];
-		}
+	blocks_copy(&from->blocks, &to->blocks, &from->dim);
+
+	memcpy(to->bits.words, from->bits.words, sizeof(t_word) * from->bits.row_words * from->dim.row);
+
+	memcpy(to->row_fill, from->row_fill, sizeof(int) * from->dim.row);
+	memcpy(to->col_fill, from->col_fill, sizeof(int) * from->dim.col);
+
+	//
+	// The squares are only copied, if both areas have squares with the same
+	// layout.
+	//
+	if (from->square_fill != NULL && to->square_fill != NULL) {
+		memcpy(to->square_fill, from->square_fill, sizeof(int) * from->square_num.row * from->square_num.col);
 	}
 }
 
@@ -376,13 +395,11 @@ void s_area_get_block(const s_area *area, const s_point *pixel, s_point *block)
  * reset the s_area.
  *****************************************************************************/
 
-void s_area_set_blocks(const s_area *area, const t_block value) {
+void s_area_set_blocks(s_area *area, const t_block value) {
 
-	for (int row = 0; row < area->dim.row; row++) {
-		for (int col = 0; col < area->dim.col; col++) {
-			area->blocks[row][col] = value;
-		}
-	}
+	blocks_set(&area->blocks, &area->dim, value);
+
+	s_area_sync(area);
 }
 
 /******************************************************************************
@@ -410,7 +427,81 @@ void s_area_create(s_area *area, const s_point *dim, const s_point *size) {
 
 	s_point_set(&area->size, size->row, size->col);
 
-	area->blocks = blocks_create(area->dim.row, area->dim.col);
+	blocks_create(&area->blocks, area->dim.row, area->dim.col);
+
+	bitboard_create(&area->bits, area->dim.row, area->dim.col);
+
+	//
+	// The blocks are not initialized, so the occupancy data is empty.
+	//
+	area->row_fill = xmalloc(sizeof(int) * area->dim.row);
+	area->col_fill = xmalloc(sizeof(int) * area->dim.col);
+
+	memset(area->row_fill, 0, sizeof(int) * area->dim.row);
+	memset(area->col_fill, 0, sizeof(int) * area->dim.col);
+
+	//
+	// By default there are no squares.
+	//
+	area->square_dim = 0;
+	s_point_set(&area->square_num, 0, 0);
+	area->square_row = NULL;
+	area->square_col = NULL;
+	area->square_fill = NULL;
+}
+
+/******************************************************************************
+ * The function divides the area into squares with the given dimension and
+ * allocates the fill counters for the squares. Squares at the borders, that
+ * do not have the full dimension, are ignored. The counters are computed from
+ * the blocks, so the blocks have to be initialized.
+ *****************************************************************************/
+
+void s_area_create_squares(s_area *area, const int square_dim) {
+
+	log_debug("Creating squares with dim: %d", square_dim);
+
+	area->square_dim = square_dim;
+
+	s_point_set(&area->square_num, area->dim.row / square_dim, area->dim.col / square_dim);
+
+	//
+	// Create the lookup tables for the rows and columns.
+	//
+	area->square_row = xmalloc(sizeof(int) * area->dim.row);
+
+	for (int row = 0; row < area->dim.row; row++) {
+		area->square_row[row] = row / square_dim < area->square_num.row ? row / square_dim : -1;
+	}
+
+	area->square_col = xmalloc(sizeof(int) * area->dim.col);
+
+	for (int col = 0; col < area->dim.col; col++) {
+		area->square_col[col] = col / square_dim < area->square_num.col ? col / square_dim : -1;
+	}
+
+	area->square_fill = xmalloc(sizeof(int) * max(area->square_num.row * area->square_num.col, 1));
+
+	s_area_sync(area);
+}
+
+/******************************************************************************
+ * The function updates the fill counter of the square of a block with a
+ * given difference, if the block is part of a complete square.
+ *****************************************************************************/
+
+static inline void s_area_square_update(s_area *area, const int row, const int col, const int diff) {
+
+	if (area->square_fill == NULL) {
+		return;
+	}
+
+	const int square_row = area->square_row[row];
+	const int square_col = area->square_col[col];
+
+	if (square_row >= 0 && square_col >= 0) {
+		area->square_fill[s_area_square_idx(area, square_row, square_col)] += diff;
+	}
 }
 
 /******************************************************************************
@@ -420,7 +511,97 @@ void s_area_create(s_area *area, const s_point *dim, const s_point *size) {
 void s_area_free(s_area *area) {
 	log_debug("Freeing area: %d/%d", area->dim.row, area->dim.col);
 
-	blocks_free(area->blocks, area->dim.row);
+	blocks_free(&area->blocks);
+
+	bitboard_free(&area->bits);
+
+	//
+	// Ensure that there is something to free.
+	//
+	if (area->row_fill == NULL) {
+		log_debug_str("Already freed!");
+		return;
+	}
+
+	free(area->row_fill);
+	free(area->col_fill);
+
+	area->row_fill = NULL;
+	area->col_fill = NULL;
+
+	//
+	// The squares are optional.
+	//
+	if (area->square_fill != NULL) {
+
+		free(area->square_row);
+		free(area->square_col);
+		free(area->square_fill);
+
+		area->square_row = NULL;
+		area->square_col = NULL;
+		area->square_fill = NULL;
+	}
+}
+
+/******************************************************************************
+ * The function recomputes the occupancy data, which is the bitboard and the
+ * fill counters, of the area from its blocks. It has to be called after the
+ * blocks were written directly.
+ *****************************************************************************/
+
+void s_area_sync(s_area *area) {
+
+	bitboard_from_blocks(&area->bits, &area->blocks, &area->dim);
+
+	//
+	// The dimension may be smaller than the allocated dimension, so we reset
+	// all counters.
+	//
+	memset(area->row_fill, 0, sizeof(int) * area->blocks.dim.row);
+	memset(area->col_fill, 0, sizeof(int) * area->blocks.dim.col);
+
+	if (area->square_fill != NULL) {
+		memset(area->square_fill, 0, sizeof(int) * area->square_num.row * area->square_num.col);
+	}
+
+	//
+	// The counters are computed from the bitboard, so only the set blocks are
+	// visited.
+	//
+	for (int row = 0; row < area->dim.row; row++) {
+		const t_word *ptr = bitboard_row(&area->bits, row);
+
+		for (int word = 0; word < area->bits.row_words; word++) {
+
+			area->row_fill[row] += __builtin_popcountll(ptr[word]);
+
+			for (t_word mask = ptr[word]; mask != 0; mask &= mask - 1) {
+				const int col = word * WORD_BITS + __builtin_ctzll(mask);
+
+				area->col_fill[col]++;
+
+				s_area_square_update(area, row, col, 1);
+			}
+		}
+	}
+}
+
+/******************************************************************************
+ * The function removes a block from the area and updates the occupancy data.
+ * It is assumed that the block is set.
+ *****************************************************************************/
+
+void s_area_remove_block(s_area *area, const int row, const int col) {
+
+	s_area_block(area, row, col) = CLR_NONE;
+
+	bitboard_unset(&area->bits, row, col);
+
+	area->row_fill[row]--;
+	area->col_fill[col]--;
+
+	s_area_square_update(area, row, col, -1);
 }
 
 /******************************************************************************
@@ -436,9 +617,11 @@ static void s_area_get_eff_lr(const s_area *area, s_point *lr) {
 	s_point_set(lr, -1, -1);
 
 	for (int row = 0; row < area->dim.row; row++) {
+		const t_block *ptr = blocks_row(&area->blocks, row);
+
 		for (int col = 0; col < area->dim.col; col++) {
 
-			if (area->blocks[row][col] == CLR_NONE) {
+			if (ptr[col] == CLR_NONE) {
 				continue;
 			}
 
@@ -475,9 +658,11 @@ void s_area_get_eff_ul(const s_area *area, s_point *ul) {
 	// Compute the upper left corner of the used area.
 	//
 	for (int row = 0; row < area->dim.row; row++) {
+		const t_block *ptr = blocks_row(&area->blocks, row);
+
 		for (int col = 0; col < area->dim.col; col++) {
 
-			if (area->blocks[row][col] == CLR_NONE) {
+			if (ptr[col] == CLR_NONE) {
 				continue;
 			}
 
@@ -536,19 +721,21 @@ void s_area_normalize(s_area *area) {
 		// Copy the used area to the origin: 0/0
 		//
 		for (int row = 0; row < area->dim.row; row++) {
+			t_block *ptr = blocks_row(&area->blocks, row);
+
 			for (int col = 0; col < area->dim.col; col++) {
 
 				//
 				// Ensure that the target is part of the area
 				//
 				if (row + ul.row < area->dim.row && col + ul.col < area->dim.col) {
-					area->blocks[row][col] = area->blocks[row + ul.row][col + ul.col];
+					ptr[col] = s_area_block(area, row + ul.row, col + ul.col);
 				}
 				//
 				// If the index is outside fill the blocks with NONE.
 				//
 				else {
-					area->blocks[row][col] = CLR_NONE;
+					ptr[col] = CLR_NONE;
 				}
 			}
 		}
@@ -566,47 +753,46 @@ void s_area_normalize(s_area *area) {
 	s_area_get_eff_lr(area, &lr);
 	s_point_set(&area->dim, lr.row + 1, lr.col + 1);
 	log_debug("new dim: %d/%d", area->dim.row, area->dim.col);
+
+	//
+	// The blocks were moved, so the bitboard has to be recomputed.
+	//
+	s_area_sync(area);
 }
 
 /******************************************************************************
- * The function check whether the drop area can be dropped anywhere on the
- * other area. If the index structure is not null, then the index of the first
- * position is stored in the structure.
+ * The function computes the set of all indices, where the drop area can be
+ * dropped on the other area. The result is stored in the anchors bitboard,
+ * which has to be created with the dimension of the area. The function
+ * returns the number of legal indices.
  *****************************************************************************/
 
-bool s_area_can_drop_anywhere(s_area *area, s_area *drop_area, s_point *idx) {
-
-	//
-	// Compute the end index to ensure that the drop area fits in the other.
-	//
-	const int row_end = area->dim.row - drop_area->dim.row;
-	const int col_end = area->dim.col - drop_area->dim.col;
-
-	log_debug("Check from 0/0 to %d,%d", row_end, col_end);
+int s_area_legal_anchors(const s_area *area, const s_area *drop_area, s_bitboard *anchors) {
+	return bitboard_anchors(&area->bits, &area->dim, &drop_area->bits, &drop_area->dim, anchors);
+}
 
-	s_point start;
+/******************************************************************************
+ * The function check whether the drop area can be dropped anywhere on the
+ * other area. The anchors bitboard has to be created with the dimension of the
+ * area and contains all legal indices afterwards. If the index structure is
+ * not null, then the index of the first position is stored in the structure.
+ *****************************************************************************/
 
-	for (start.row = 0; start.row <= row_end; start.row++) {
-		for (start.col = 0; start.col <= col_end; start.col++) {
+bool s_area_can_drop_anywhere(const s_area *area, const s_area *drop_area, s_bitboard *anchors, s_point *idx) {
 
-			//
-			// Check if the drop area can be dropped at this place.
-			//
-			if (s_area_drop(area, &start, drop_area, false)) {
-				log_debug("Can drop at index: %d/%d", start.row, start.col);
+	if (s_area_legal_anchors(area, drop_area, anchors) == 0) {
+		return false;
+	}
 
-				//
-				// Store the index, if requested.
-				//
-				if (idx != NULL) {
-					s_point_copy(idx, &start);
-				}
-				return true;
-			}
-		}
+	//
+	// Store the index, if requested.
+	//
+	if (idx != NULL) {
+		bitboard_first(anchors, idx);
+		log_debug("Can drop at index: %d/%d", idx->row, idx->col);
 	}
 
-	return false;
+	return true;
 }
 
 /******************************************************************************
@@ -614,131 +800,55 @@ bool s_area_can_drop_anywhere(s_area *area, s_area *drop_area, s_point *idx) {
  * is possible. It is assumed that the drop area fits in the game area. So the
  * function checks whether there is already a block at the position, which
  * blocks the dropping.
+ *
+ * The check is done with the bitboards of both areas. Each row of the drop
+ * area is a mask, which is shifted to the column of the index and compared
+ * with the corresponding row of the area.
  *****************************************************************************/
 
 bool s_area_drop(s_area *area, const s_point *idx, const s_area *drop_area, const bool do_drop) {
 
-	for (int row = 0; row < drop_area->dim.row; row++) {
-		for (int col = 0; col < drop_area->dim.col; col++) {
-
-			//
-			// If the block of the used area is not defined, there is nothing
-			// to do or to check.
-			//
-			if (drop_area->blocks[row][col] == CLR_NONE) {
-				continue;
-			}
-
-			//
-			// If there is a block on the game area defined, dropping is not
-			// possible.
-			//
-			if (area->blocks[idx->row + row][idx->col + col] != CLR_NONE) {
-				return false;
-			}
-
-			//
-			// At this point dropping of current block is possible. The flag
-			// defines whether the dropping should be performed.
-			//
-			if (do_drop) {
-				area->blocks[idx->row + row][idx->col + col] = drop_area->blocks[row][col];
-			}
-		}
-	}
-
-	log_debug("can drop at: %d/%d", idx->row, idx->col);
-
-	return true;
-}
-
-/******************************************************************************
- * The function print a block of a s_area, with a given character. It is
- * assumed that the color is already set.
- *****************************************************************************/
-
-void s_area_print_block(WINDOW *win, const s_area *area, const s_point *idx, const wchar_t ch) {
-
-	//
-	// Get the upper left corner of the block with the given index.
 	//
-	const s_point ul = s_area_get_ul(area, idx);
-
-	//
-	// Get the lower right corner of the block with the given index.
+	// If there is a block on the game area defined, dropping is not possible.
 	//
-	const s_point lr = { ul.row + area->size.row, ul.col + area->size.col };
-
-	for (int row = ul.row; row < lr.row; row++) {
-		for (int col = ul.col; col < lr.col; col++) {
-			mvwprintw(win, row, col, "%lc", ch);
-		}
+	if (!bitboard_fits(&area->bits, &drop_area->bits, &drop_area->dim, idx)) {
+		return false;
 	}
-}
-
-/******************************************************************************
- * The function prints an empty area with a chess pattern. This can be used as
- * an initialization.
- *****************************************************************************/
 
-void s_area_print_chess(WINDOW *win, const s_area *area, const e_chess_type chess_type) {
-	wchar_t chr;
-	t_block ga_color;
-	s_point idx;
+	log_debug("can drop at: %d/%d", idx->row, idx->col);
 
 	//
-	// Iterate through the blocks of the game area.
+	// At this point dropping is possible. The flag defines whether the
+	// dropping should be performed.
 	//
-	for (idx.row = 0; idx.row < area->dim.row; idx.row++) {
-		for (idx.col = 0; idx.col < area->dim.col; idx.col++) {
+	if (!do_drop) {
+		return true;
+	}
 
-			//
-			// Get the color of the game area depending on the chess pattern
-			// type.
-			//
-			ga_color = area->blocks[idx.row][idx.col];
+	for (int row = 0; row < drop_area->dim.row; row++) {
+		const t_block *drop_ptr = blocks_row(&drop_area->blocks, row);
+		t_block *area_ptr = &blocks_row(&area->blocks, idx->row + row)[idx->col];
 
-			//
-			// Set the color pair and get the character to display.
-			//
-			chr = colors_chess_attr_char(win, ga_color, CLR_NONE, &idx, chess_type);
+		for (int col = 0; col < drop_area->dim.col; col++) {
 
 			//
-			// Print the block with a given color and character.
+			// If the block of the used area is not defined, there is nothing
+			// to do.
 			//
-			s_area_print_block(win, area, &idx, chr);
-		}
-	}
-}
+			if (drop_ptr[col] == CLR_NONE) {
+				continue;
+			}
 
-/******************************************************************************
- * The function prints a pixel with a given color. The background is a chess
- * pattern.
- *****************************************************************************/
+			area_ptr[col] = drop_ptr[col];
 
-void s_area_print_chess_pixel(WINDOW *win, const s_area *area, const s_point *pixel, const t_block da_color, const e_chess_type chess_type) {
+			bitboard_set(&area->bits, idx->row + row, idx->col + col);
 
-	log_debug("pixel: %d/%d, fg-color: %d", pixel->row, pixel->col, da_color);
+			area->row_fill[idx->row + row]++;
+			area->col_fill[idx->col + col]++;
 
-	//
-	// Get the background color of the pixel. We need the corresponding game
-	// block, which contains the color.
-	//
-	s_point block_idx;
-	s_area_get_block(area, pixel, &block_idx);
-
-	//
-	// Get the color of the game area depending on the chess pattern type.
-	//
-	const t_block ga_color = area->blocks[block_idx.row][block_idx.col];
-
-	//
-	// Set the color pair and get the character to display.
-	//
-	const wchar_t chr = colors_chess_attr_char(win, ga_color, da_color, &block_idx, chess_type);
+			s_area_square_update(area, idx->row + row, idx->col + col, 1);
+		}
+	}
 
-	//
-	// Print the character at the position.
-	//
-	mvwprintw(win, pixel->row, pixel->col, "%lc", chr);
+	return true;
 }
@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "s_area_print.h"
+#include "colors.h"
+
+/******************************************************************************
+ * The function print a block of a s_area, with a given character and
+ * attribute.
+ *****************************************************************************/
+
+void s_area_print_block(s_cells *cells, const s_area *area, const s_point *idx, const wchar_t ch, const attr_t attr) {
+
+	//
+	// Get the upper left corner of the block with the given index.
+	//
+	const s_point ul = s_area_get_ul(area, idx);
+
+	//
+	// Get the lower right corner of the block with the given index.
+	//
+	const s_point lr = { ul.row + area->size.row, ul.col + area->size.col };
+
+	for (int row = ul.row; row < lr.row; row++) {
+		for (int col = ul.col; col < lr.col; col++) {
+			cells_set(cells, row, col, ch, attr);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function prints an empty area with a chess pattern. This can be used as
+ * an initialization.
+ *****************************************************************************/
+
+void s_area_print_chess(s_cells *cells, const s_area *area, const e_chess_type chess_type) {
+	const s_cell *cell;
+	t_block ga_color;
+	s_point idx;
+
+	//
+	// Iterate through the blocks of the game area.
+	//
+	for (idx.row = 0; idx.row < area->dim.row; idx.row++) {
+		const t_block *ptr = blocks_row(&area->blocks, idx.row);
+
+		for (idx.col = 0; idx.col < area->dim.col; idx.col++) {
+
+			//
+			// Get the color of the game area depending on the chess pattern
+			// type.
+			//
+			ga_color = ptr[idx.col];
+
+			//
+			// Get the precomputed attribute and character to display.
+			//
+			cell = colors_chess_cell(ga_color, CLR_NONE, &idx, chess_type, area->square_dim);
+
+			//
+			// Print the block with a given color and character.
+			//
+			s_area_print_block(cells, area, &idx, cell->chr, cell->attr);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function prints a pixel with a given color. The background is a chess
+ * pattern.
+ *****************************************************************************/
+
+void s_area_print_chess_pixel(s_cells *cells, const s_area *area, const s_point *pixel, const s_point *block_idx, const t_block da_color, const e_chess_type chess_type) {
+
+	log_debug("pixel: %d/%d, block: %d/%d fg-color: %d", pixel->row, pixel->col, block_idx->row, block_idx->col, da_color);
+
+	//
+	// Get the color of the game area depending on the chess pattern type.
+	//
+	const t_block ga_color = s_area_block(area, block_idx->row, block_idx->col);
+
+	//
+	// Get the precomputed attribute and character to display.
+	//
+	const s_cell *cell = colors_chess_cell(ga_color, da_color, block_idx, chess_type, area->square_dim);
+
+	//
+	// Print the character at the position.
+	//
+	cells_set(cells, pixel->row, pixel->col, cell->chr, cell->attr);
+}
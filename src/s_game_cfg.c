@@ -28,7 +28,6 @@
 
 #include "s_game_cfg.h"
 
-#include "colors.h"
 #include "file_system.h"
 #include "rules.h"
 
@@ -40,13 +39,13 @@
   * s_game_cfg struct.
   ******************************************************************************/
 
-void init_random_shapes_read(const char *path);
+void init_random_shapes_read(s_game_data *game_data, const char *path);
 
-void init_random_shapes(const s_game_cfg *game_cfg, t_block **blocks);
+void init_random_shapes(const s_game_cfg *game_cfg, const s_game_data *game_data, s_rng *rng, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim);
 
-void init_random_colors_setup(const char *data);
+void init_random_colors_setup(s_game_data *game_data, const char *data);
 
-void init_random_colors(const s_game_cfg *game_cfg, t_block **blocks);
+void init_random_colors(const s_game_cfg *game_cfg, const s_game_data *game_data, s_rng *rng, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim);
 
 /*******************************************************************************
  * Declaration of an array for game configurations.
@@ -82,6 +81,8 @@ s_game_cfg _game_cfg[S_GAMES_CFG_MAX];
 
 #define CFG_DROP_DIM_COL "drop.dim.col"
 
+#define CFG_GAME_SQUARE_DIM "game.square.dim"
+
 #define CFG_HOME_NUM "home.num"
 
 #define CFG_HOME_SIZE_ROW "home.size.row"
@@ -230,6 +231,8 @@ void s_game_debug(const s_game_cfg *game_cfg) {
 
 	log_debug("drop dim: %d/%d", game_cfg->drop_dim.row, game_cfg->drop_dim.col);
 
+	log_debug("square dim: %d", game_cfg->square_dim);
+
 	log_debug("home num: %d", game_cfg->home_num);
 	log_debug("home size: %d/%d", game_cfg->home_size.row, game_cfg->home_size.col);
 
@@ -264,6 +267,11 @@ static void s_game_init() {
 
 		s_point_set(&_game_cfg[i].drop_dim, -1, -1);
 
+		//
+		// The square dimension is optional.
+		//
+		_game_cfg[i].square_dim = RULES_SQUARE_DIM;
+
 		_game_cfg[i].home_num = -1;
 
 		_game_cfg[i].color = -1;
@@ -318,6 +326,18 @@ static void s_game_check() {
 			log_exit("Game: %d - not set: '%s' or '%s'", i, CFG_DROP_DIM_ROW, CFG_DROP_DIM_COL);
 		}
 
+		//
+		// A row of a drop area is used as a bit mask, which has to fit in a
+		// single word of the bitboard.
+		//
+		if (_game_cfg[i].drop_dim.col > WORD_BITS) {
+			log_exit("Game: %d - '%s' too large: %d (max: %d)", i, CFG_DROP_DIM_COL, _game_cfg[i].drop_dim.col, WORD_BITS);
+		}
+
+		if (_game_cfg[i].square_dim < 1) {
+			log_exit("Game: %d - invalid: '%s': %d", i, CFG_GAME_SQUARE_DIM, _game_cfg[i].square_dim);
+		}
+
 		if (_game_cfg[i].home_num < 0) {
 			log_exit("Game: %d - not set: '%s'", i, CFG_HOME_NUM);
 		}
@@ -444,6 +464,9 @@ static void s_game_cfg_process(FILE *file, const char *path) {
 			} else if (starts_with(line, CFG_DROP_DIM_COL)) {
 				game->drop_dim.col = cfg_get_int(line);
 
+			} else if (starts_with(line, CFG_GAME_SQUARE_DIM)) {
+				game->square_dim = cfg_get_int(line);
+
 			} else if (starts_with(line, CFG_HOME_NUM)) {
 				game->home_num = cfg_get_int(line);
 
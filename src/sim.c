@@ -0,0 +1,567 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "sim.h"
+
+/******************************************************************************
+ * The names of the policies and the end reasons. The policy names are used as
+ * command line values.
+ *****************************************************************************/
+
+static const char *_policy_str[SIM_POLICY_NUM] = { "random", "first-fit", "greedy", "eval", "solver" };
+
+static const char *_end_str[SIM_END_NUM] = { "no home area fits", "turn limit reached" };
+
+/******************************************************************************
+ * The function returns the name of a policy.
+ *****************************************************************************/
+
+const char* sim_policy_str(const e_sim_policy policy) {
+	return _policy_str[policy];
+}
+
+/******************************************************************************
+ * The function returns the policy with the given name. If the name is not
+ * known, the program terminates.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+e_sim_policy sim_policy_parse(const char *str) {
+
+	for (int i = 0; i < SIM_POLICY_NUM; i++) {
+
+		if (strcmp(str, _policy_str[i]) == 0) {
+			return (e_sim_policy) i;
+		}
+	}
+
+	log_exit("Unknown policy: %s", str);
+}
+
+/******************************************************************************
+ * The function returns a description of an end reason.
+ *****************************************************************************/
+
+const char* sim_end_str(const e_sim_end end) {
+	return _end_str[end];
+}
+
+/******************************************************************************
+ * The function creates the simulation for a game configuration. The engine
+ * is created with seed 0, each game is reset with its own seed.
+ *****************************************************************************/
+
+void sim_create(s_sim *sim, const s_game_cfg *game_cfg, const s_sim_opts *opts) {
+
+	log_debug("Create simulation: %s policy: %s", game_cfg->title, sim_policy_str(opts->policy));
+
+	engine_create(&sim->engine, game_cfg, 0);
+
+	sim->opts = *opts;
+
+	if (opts->policy == SIM_POLICY_SOLVER) {
+		solver_create(&sim->solver, &sim->engine, &eval_weights_default, opts->beam, opts->expect);
+	}
+
+	eval_create(&sim->eval, game_cfg);
+
+	bitboard_create(&sim->anchors, game_cfg->game_dim.row, game_cfg->game_dim.col);
+}
+
+/******************************************************************************
+ * The function frees the simulation.
+ *****************************************************************************/
+
+void sim_free(s_sim *sim) {
+
+	engine_free(&sim->engine);
+
+	eval_free(&sim->eval);
+
+	if (sim->opts.policy == SIM_POLICY_SOLVER) {
+		solver_free(&sim->solver);
+	}
+
+	bitboard_free(&sim->anchors);
+}
+
+/******************************************************************************
+ * The function returns the n-th legal position of the anchors bitboard in
+ * row major order. The number has to be less than the number of set bits.
+ *****************************************************************************/
+
+static void sim_nth_anchor(const s_bitboard *anchors, int num, s_point *idx) {
+
+	for (int row = 0; row < anchors->dim.row; row++) {
+		const t_word *ptr = bitboard_row(anchors, row);
+
+		for (int word = 0; word < anchors->row_words; word++) {
+			const int count = __builtin_popcountll(ptr[word]);
+
+			if (num >= count) {
+				num -= count;
+				continue;
+			}
+
+			t_word mask = ptr[word];
+
+			for (; num > 0; num--) {
+				mask &= mask - 1;
+			}
+
+			s_point_set(idx, row, word * WORD_BITS + __builtin_ctzll(mask));
+			return;
+		}
+	}
+
+	log_exit("Anchor not found: %d", num);
+}
+
+/******************************************************************************
+ * The random policy selects one of the legal moves of all home areas with the
+ * same probability.
+ *****************************************************************************/
+
+static bool sim_select_random(s_sim *sim, int *home_idx, s_point *idx) {
+	int total = 0;
+
+	for (int i = 0; i < sim->engine.home_num; i++) {
+		total += engine_home_anchors(&sim->engine, i, &sim->anchors);
+	}
+
+	if (total == 0) {
+		return false;
+	}
+
+	int num = rng_int(&sim->rng, total);
+
+	//
+	// Search the home area with the selected move.
+	//
+	for (int i = 0; i < sim->engine.home_num; i++) {
+		const int count = engine_home_anchors(&sim->engine, i, &sim->anchors);
+
+		if (num < count) {
+			sim_nth_anchor(&sim->anchors, num, idx);
+			*home_idx = i;
+			return true;
+		}
+
+		num -= count;
+	}
+
+	log_exit("Move not found: %d", num);
+}
+
+/******************************************************************************
+ * The first fit policy selects the first legal position of the first home
+ * area, that can be dropped.
+ *****************************************************************************/
+
+static bool sim_select_first_fit(s_sim *sim, int *home_idx, s_point *idx) {
+
+	for (int i = 0; i < sim->engine.home_num; i++) {
+
+		if (engine_home_anchors(&sim->engine, i, &sim->anchors) > 0) {
+			bitboard_first(&sim->anchors, idx);
+			*home_idx = i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/******************************************************************************
+ * The greedy and the eval policy select the best move of the evaluator with
+ * the given weights.
+ *****************************************************************************/
+
+static bool sim_select_eval(s_sim *sim, const s_eval_weights *weights, int *home_idx, s_point *idx) {
+	s_eval_move move;
+
+	if (!eval_best_move(&sim->eval, &sim->engine, weights, &move)) {
+		return false;
+	}
+
+	*home_idx = move.home_idx;
+	s_point_copy(idx, &move.idx);
+
+	return true;
+}
+
+/******************************************************************************
+ * The solver policy selects the first move of the best path of the solver.
+ *****************************************************************************/
+
+static bool sim_select_solver(s_sim *sim, int *home_idx, s_point *idx) {
+	s_eval_move move;
+
+	if (!solver_best_move(&sim->solver, &sim->engine, &move)) {
+		return false;
+	}
+
+	*home_idx = move.home_idx;
+	s_point_copy(idx, &move.idx);
+
+	return true;
+}
+
+/******************************************************************************
+ * The function selects the next move with the policy of the simulation. It
+ * returns false if no move is possible.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool sim_select_move(s_sim *sim, int *home_idx, s_point *idx) {
+
+	switch (sim->opts.policy) {
+
+	case SIM_POLICY_RANDOM:
+		return sim_select_random(sim, home_idx, idx);
+
+	case SIM_POLICY_FIRST_FIT:
+		return sim_select_first_fit(sim, home_idx, idx);
+
+	case SIM_POLICY_GREEDY:
+		return sim_select_eval(sim, &eval_weights_greedy, home_idx, idx);
+
+	case SIM_POLICY_EVAL:
+		return sim_select_eval(sim, &eval_weights_default, home_idx, idx);
+
+	case SIM_POLICY_SOLVER:
+		return sim_select_solver(sim, home_idx, idx);
+
+	default:
+		log_exit("Unknown policy: %d", sim->opts.policy);
+	}
+}
+
+/******************************************************************************
+ * The function plays a complete game with a given seed. If the maximum number
+ * of turns is greater than 0, the game ends after that number of turns. The
+ * result is stored in the game struct.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void sim_play_game(s_sim *sim, const uint32_t seed, const int max_turns, s_sim_game *game) {
+	s_engine *engine = &sim->engine;
+	int home_idx;
+	s_point idx;
+
+	engine_reset(engine, seed);
+
+	//
+	// The random policy gets a different sequence than the engine.
+	//
+	rng_seed(&sim->rng, ~seed);
+
+	game->end = SIM_END_NO_FIT;
+
+	while (!engine_is_end(engine)) {
+
+		if (max_turns > 0 && engine->turns >= max_turns) {
+			game->end = SIM_END_MAX_TURNS;
+			break;
+		}
+
+		if (!sim_select_move(sim, &home_idx, &idx)) {
+			break;
+		}
+
+		if (engine_apply_move(engine, home_idx, &idx) == ENGINE_ILLEGAL) {
+			log_exit("Illegal move: %d at %d/%d", home_idx, idx.row, idx.col);
+		}
+	}
+
+	game->score = engine->score;
+	game->turns = engine->turns;
+
+	log_debug("Game: %u score: %d turns: %d end: %s", seed, game->score, game->turns, sim_end_str(game->end));
+}
+
+/******************************************************************************
+ * The function initializes the statistics with an array for the scores of a
+ * maximum number of games.
+ *****************************************************************************/
+
+static void sim_stats_init(s_sim_stats *stats, const int max_games, int *scores) {
+
+	memset(stats, 0, sizeof(s_sim_stats));
+
+	stats->max_games = max_games;
+
+	stats->scores = scores;
+}
+
+/******************************************************************************
+ * The function creates the statistics for a maximum number of games.
+ *****************************************************************************/
+
+void sim_stats_create(s_sim_stats *stats, const int max_games) {
+	sim_stats_init(stats, max_games, xmalloc(sizeof(int) * max_games));
+}
+
+/******************************************************************************
+ * The function frees the statistics.
+ *****************************************************************************/
+
+void sim_stats_free(s_sim_stats *stats) {
+
+	free(stats->scores);
+	stats->scores = NULL;
+}
+
+/******************************************************************************
+ * The function adds the result of a game to the statistics. The score is
+ * stored at the index of the game.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void sim_stats_add(s_sim_stats *stats, const int game_idx, const s_sim_game *game) {
+
+	if (game_idx < 0 || game_idx >= stats->max_games) {
+		log_exit("Invalid game index: %d", game_idx);
+	}
+
+	if (stats->games == 0 || game->turns < stats->turns_min) {
+		stats->turns_min = game->turns;
+	}
+
+	if (stats->games == 0 || game->turns > stats->turns_max) {
+		stats->turns_max = game->turns;
+	}
+
+	stats->games++;
+
+	stats->scores[game_idx] = game->score;
+
+	stats->turns += game->turns;
+
+	stats->ends[game->end]++;
+}
+
+/******************************************************************************
+ * The function merges the statistics of a worker. The scores are not copied,
+ * because the statistics share the array of the scores.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void sim_stats_merge(s_sim_stats *to, const s_sim_stats *from) {
+
+	if (from->games == 0) {
+		return;
+	}
+
+	if (to->games == 0 || from->turns_min < to->turns_min) {
+		to->turns_min = from->turns_min;
+	}
+
+	if (to->games == 0 || from->turns_max > to->turns_max) {
+		to->turns_max = from->turns_max;
+	}
+
+	to->games += from->games;
+
+	to->turns += from->turns;
+
+	for (int i = 0; i < SIM_END_NUM; i++) {
+		to->ends[i] += from->ends[i];
+	}
+}
+
+/******************************************************************************
+ * The job of a parallel run. The workers take the games in chunks from the
+ * atomic counter, which is the only data, that is written by all workers.
+ *****************************************************************************/
+
+typedef struct s_sim_job {
+
+	uint32_t seed;
+
+	int num_games;
+
+	int max_turns;
+
+	atomic_long next;
+
+} s_sim_job;
+
+/******************************************************************************
+ * A worker owns the simulation, which contains the game area, the random
+ * number generators and the scratch data, and the statistics of its games.
+ *****************************************************************************/
+
+typedef struct s_sim_worker {
+
+	pthread_t thread;
+
+	s_sim sim;
+
+	s_sim_stats stats;
+
+	s_sim_job *job;
+
+} s_sim_worker;
+
+/******************************************************************************
+ * The function of a worker thread. It plays chunks of games until all games
+ * are taken. The game i is played with the seed + i, so the results do not
+ * depend on the number of threads.
+ *****************************************************************************/
+
+static void* sim_worker_run(void *ptr) {
+	s_sim_worker *worker = ptr;
+	s_sim_job *job = worker->job;
+	s_sim_game game;
+
+	for (;;) {
+		const long start = atomic_fetch_add_explicit(&job->next, SIM_CHUNK, memory_order_relaxed);
+
+		if (start >= job->num_games) {
+			break;
+		}
+
+		const int end = (int) min(start + SIM_CHUNK, (long) job->num_games);
+
+		for (int i = (int) start; i < end; i++) {
+			sim_play_game(&worker->sim, job->seed + (uint32_t) i, job->max_turns, &game);
+			sim_stats_add(&worker->stats, i, &game);
+		}
+	}
+
+	return NULL;
+}
+
+/******************************************************************************
+ * The function plays the games of the statistics with a pool of worker
+ * threads. Each worker has its own simulation and statistics, which are
+ * merged after all workers finished. With a single thread, the games are
+ * played by the calling thread.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+void sim_run(const s_game_cfg *game_cfg, const s_sim_opts *opts, const uint32_t seed, const int max_turns, const int num_threads, s_sim_stats *stats) {
+
+	s_sim_job job = { .seed = seed, .num_games = stats->max_games, .max_turns = max_turns };
+
+	atomic_init(&job.next, 0);
+
+	s_sim_worker *workers = xmalloc(sizeof(s_sim_worker) * num_threads);
+
+	//
+	// The simulations are created before the threads are started. This
+	// ensures that the kernels of the blocks are selected by the main
+	// thread.
+	//
+	for (int i = 0; i < num_threads; i++) {
+		sim_create(&workers[i].sim, game_cfg, opts);
+		sim_stats_init(&workers[i].stats, stats->max_games, stats->scores);
+		workers[i].job = &job;
+	}
+
+	if (num_threads == 1) {
+		sim_worker_run(&workers[0]);
+
+	} else {
+
+		for (int i = 0; i < num_threads; i++) {
+
+			const int error = pthread_create(&workers[i].thread, NULL, sim_worker_run, &workers[i]);
+
+			if (error != 0) {
+				log_exit("Unable to create thread: %d - %s", i, strerror(error));
+			}
+		}
+
+		for (int i = 0; i < num_threads; i++) {
+
+			const int error = pthread_join(workers[i].thread, NULL);
+
+			if (error != 0) {
+				log_exit("Unable to join thread: %d - %s", i, strerror(error));
+			}
+		}
+	}
+
+	for (int i = 0; i < num_threads; i++) {
+		sim_stats_merge(stats, &workers[i].stats);
+		sim_free(&workers[i].sim);
+	}
+
+	free(workers);
+}
+
+/******************************************************************************
+ * The compare function for sorting the scores.
+ *****************************************************************************/
+
+static int sim_cmp_int(const void *a, const void *b) {
+	const int x = *(const int*) a;
+	const int y = *(const int*) b;
+
+	return (x > y) - (x < y);
+}
+
+/******************************************************************************
+ * The function prints the statistics. The scores are sorted to compute the
+ * distribution.
+ *****************************************************************************/
+
+void sim_stats_print(FILE *stream, s_sim_stats *stats, const double seconds) {
+	const int num = stats->games;
+
+	if (num == 0) {
+		fprintf(stream, "No games played.\n");
+		return;
+	}
+
+	qsort(stats->scores, num, sizeof(int), sim_cmp_int);
+
+	long sum = 0;
+
+	for (int i = 0; i < num; i++) {
+		sum += stats->scores[i];
+	}
+
+	fprintf(stream, "Games      : %d\n", num);
+	fprintf(stream, "Time       : %.3f s\n", seconds);
+	fprintf(stream, "Games/sec  : %.1f\n", seconds > 0 ? num / seconds : 0.0);
+	fprintf(stream, "Turns/game : %.1f (min: %d max: %d)\n", (double) stats->turns / num, stats->turns_min, stats->turns_max);
+	fprintf(stream, "Score      : %.1f (min: %d p25: %d median: %d p75: %d max: %d)\n", (double) sum / num, stats->scores[0], stats->scores[(num - 1) / 4],
+			stats->scores[(num - 1) / 2], stats->scores[(num - 1) * 3 / 4], stats->scores[num - 1]);
+
+	for (int i = 0; i < SIM_END_NUM; i++) {
+		fprintf(stream, "End        : %-20s %ld\n", sim_end_str(i), stats->ends[i]);
+	}
+}
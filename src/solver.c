@@ -0,0 +1,603 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "solver.h"
+#include "rules.h"
+#include "init_random_shapes.h"
+
+/******************************************************************************
+ * The seed of the random keys for the hashing. The keys are the same for all
+ * solvers.
+ *****************************************************************************/
+
+#define SOLVER_SEED 0x5eed
+
+/******************************************************************************
+ * The function creates an area with the dimension of the game area. The rules
+ * of the squares-lines games require the squares.
+ *****************************************************************************/
+
+static void solver_area_create(s_area *area, const s_game_cfg *game_cfg) {
+
+	s_area_create(area, &game_cfg->game_dim, &game_cfg->game_size);
+
+	if (game_cfg->type == TYPE_SQUARES_LINES) {
+		s_area_create_squares(area, game_cfg->square_dim);
+	}
+}
+
+/******************************************************************************
+ * The function creates the distinct normalized shapes of the game data with
+ * their number, for the expected value of the next refill. The shapes are
+ * clipped to the dimension of the drop area, like the refilling does.
+ *****************************************************************************/
+
+static void solver_pieces_create(s_solver *solver, const s_engine *engine) {
+	const s_game_cfg *game_cfg = engine->game_cfg;
+	const s_game_data *game_data = &engine->game_data;
+	const s_point *dim = &game_cfg->drop_dim;
+
+	solver->pieces = xmalloc(sizeof(s_solver_piece) * game_data->num_shapes);
+
+	for (int i = 0; i < game_data->num_shapes; i++) {
+		const s_shape *shape = &game_data->shapes[i];
+		s_solver_piece *piece = &solver->pieces[solver->num_pieces];
+
+		s_area_create(&piece->area, dim, &game_cfg->game_size);
+
+		blocks_set(&piece->area.blocks, dim, CLR_NONE);
+
+		for (int j = 0; j < shape->num_cells; j++) {
+			const int row = shape->ul.row + shape->cells[j].row;
+			const int col = shape->ul.col + shape->cells[j].col;
+
+			if (row < dim->row && col < dim->col) {
+				blocks_at(&piece->area.blocks, row, col) = game_cfg->color;
+			}
+		}
+
+		s_area_normalize(&piece->area);
+
+		//
+		// Search a piece with the same normalized form.
+		//
+		int k;
+
+		for (k = 0; k < solver->num_pieces; k++) {
+			const s_area *other = &solver->pieces[k].area;
+
+			if (s_point_same(&other->dim, &piece->area.dim) && memcmp(other->bits.words, piece->area.bits.words, sizeof(t_word) * piece->area.bits.row_words * piece->area.dim.row) == 0) {
+				break;
+			}
+		}
+
+		if (k < solver->num_pieces) {
+			solver->pieces[k].weight++;
+			s_area_free(&piece->area);
+
+		} else {
+			piece->weight = 1;
+			solver->num_pieces++;
+		}
+
+		solver->total_weight++;
+	}
+
+	log_debug("Shapes: %d pieces: %d", game_data->num_shapes, solver->num_pieces);
+}
+
+/******************************************************************************
+ * The function creates the solver for the engine. The data of the solver has
+ * the dimension of the game area, so the solver can be used for all engines
+ * of the same game configuration. If the expect flag is set and the game has
+ * shapes, the expected value of the next refill is computed.
+ *****************************************************************************/
+
+void solver_create(s_solver *solver, const s_engine *engine, const s_eval_weights *weights, const int beam, const bool expect) {
+	const s_game_cfg *game_cfg = engine->game_cfg;
+	const int num = game_cfg->game_dim.row * game_cfg->game_dim.col;
+
+	log_debug("Create solver: %s beam: %d expect: %s", game_cfg->title, beam, bool_str(expect));
+
+	if (beam < 1) {
+		log_exit("Invalid beam: %d", beam);
+	}
+
+	solver->game_cfg = game_cfg;
+	solver->weights = weights;
+	solver->beam = beam;
+
+	for (int i = 0; i < 2; i++) {
+		solver->layers[i] = xmalloc(sizeof(s_solver_node) * beam);
+
+		for (int j = 0; j < beam; j++) {
+			solver_area_create(&solver->layers[i][j].area, game_cfg);
+		}
+	}
+
+	//
+	// Each node of a layer can drop each home area at each block.
+	//
+	solver->max_children = beam * game_cfg->home_num * num;
+	solver->children = xmalloc(sizeof(s_solver_child) * solver->max_children);
+
+	//
+	// The size of the hash table is a power of two, which is at least twice
+	// the number of candidates.
+	//
+	int size = 1;
+
+	while (size < 2 * solver->max_children) {
+		size *= 2;
+	}
+
+	solver->table = xmalloc(sizeof(int) * size);
+	solver->table_mask = size - 1;
+
+	//
+	// Create the random keys.
+	//
+	s_rng rng;
+	rng_seed(&rng, SOLVER_SEED);
+
+	solver->keys = xmalloc(sizeof(uint64_t) * num * SOLVER_COLORS);
+
+	for (int i = 0; i < num * SOLVER_COLORS; i++) {
+		solver->keys[i] = rng_next(&rng);
+	}
+
+	for (int i = 0; i < (1 << ENGINE_HOME_MAX); i++) {
+		solver->used_keys[i] = rng_next(&rng);
+	}
+
+	solver_area_create(&solver->scratch, game_cfg);
+
+	rules_create_game(&solver->rules, &solver->scratch);
+
+	for (int i = 0; i < ENGINE_HOME_MAX; i++) {
+		s_area_create(&solver->drop_areas[i], &game_cfg->drop_dim, &game_cfg->game_size);
+	}
+
+	bitboard_create(&solver->anchors, game_cfg->game_dim.row, game_cfg->game_dim.col);
+
+	solver->pieces = NULL;
+	solver->num_pieces = 0;
+	solver->total_weight = 0;
+
+	solver->cancel = NULL;
+
+	if (expect && engine->game_data.shapes != NULL && engine->game_data.num_shapes > 0) {
+		solver_pieces_create(solver, engine);
+	}
+}
+
+/******************************************************************************
+ * The function frees the solver.
+ *****************************************************************************/
+
+void solver_free(s_solver *solver) {
+
+	for (int i = 0; i < 2; i++) {
+
+		for (int j = 0; j < solver->beam; j++) {
+			s_area_free(&solver->layers[i][j].area);
+		}
+
+		free(solver->layers[i]);
+		solver->layers[i] = NULL;
+	}
+
+	free(solver->children);
+	solver->children = NULL;
+
+	free(solver->table);
+	solver->table = NULL;
+
+	free(solver->keys);
+	solver->keys = NULL;
+
+	s_area_free(&solver->scratch);
+
+	rules_free_game(&solver->rules);
+
+	for (int i = 0; i < ENGINE_HOME_MAX; i++) {
+		s_area_free(&solver->drop_areas[i]);
+	}
+
+	bitboard_free(&solver->anchors);
+
+	for (int i = 0; i < solver->num_pieces; i++) {
+		s_area_free(&solver->pieces[i].area);
+	}
+
+	free(solver->pieces);
+	solver->pieces = NULL;
+}
+
+/******************************************************************************
+ * The function computes the hash of a game area and the used home areas. The
+ * hash is the xor of the random keys of the blocks, that are set.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+uint64_t solver_hash(const s_solver *solver, const s_area *area, const int used) {
+	uint64_t hash = solver->used_keys[used];
+
+	for (int row = 0; row < area->dim.row; row++) {
+		const t_word *ptr = bitboard_row(&area->bits, row);
+
+		for (int word = 0; word < area->bits.row_words; word++) {
+
+			for (t_word mask = ptr[word]; mask != 0; mask &= mask - 1) {
+				const int col = word * WORD_BITS + __builtin_ctzll(mask);
+
+				const int block = s_area_block(area, row, col) & (SOLVER_COLORS - 1);
+
+				hash ^= solver->keys[(row * area->dim.col + col) * SOLVER_COLORS + block];
+			}
+		}
+	}
+
+	return hash;
+}
+
+/******************************************************************************
+ * The function drops a normalized area on the scratch area, which is a copy
+ * of the given area, and returns the number of removed blocks.
+ *****************************************************************************/
+
+static int solver_drop(s_solver *solver, const s_area *area, s_area *to, const s_area *drop_area, const s_point *idx) {
+
+	s_area_copy_deep(area, to);
+
+	if (!s_area_drop(to, idx, drop_area, true)) {
+		log_exit("Unable to drop area at: %d/%d", idx->row, idx->col);
+	}
+
+	return solver->game_cfg->fct_ptr_rules_remove(&solver->rules, to, drop_area, idx);
+}
+
+/******************************************************************************
+ * The function computes the value of a game area. It is the weighted number
+ * of removed blocks minus the weighted holes and transitions.
+ *****************************************************************************/
+
+static int solver_value(const s_solver *solver, const s_area *area, const int removed) {
+	const s_eval_weights *weights = solver->weights;
+
+	int value = weights->removed * removed;
+
+	if (weights->holes != 0) {
+		value -= weights->holes * eval_holes(&area->bits, &area->dim);
+	}
+
+	if (weights->transitions != 0) {
+		value -= weights->transitions * eval_transitions(&area->bits, &area->dim);
+	}
+
+	return value;
+}
+
+/******************************************************************************
+ * The function computes the expected value of a random shape on a game area.
+ * The value of a shape is the weighted number of blocks of its best drop plus
+ * the weighted number of its legal positions. A shape, that cannot be
+ * dropped, has the negative no fit weight.
+ *****************************************************************************/
+
+static int solver_expect(s_solver *solver, const s_area *area) {
+	const s_eval_weights *weights = solver->weights;
+	long sum = 0;
+	s_point idx;
+
+	for (int i = 0; i < solver->num_pieces; i++) {
+		const s_solver_piece *piece = &solver->pieces[i];
+
+		const int num = bitboard_anchors(&area->bits, &area->dim, &piece->area.bits, &piece->area.dim, &solver->anchors);
+
+		if (num == 0) {
+			sum -= (long) weights->no_fit * piece->weight;
+			continue;
+		}
+
+		int best = 0;
+
+		for (idx.row = 0; idx.row < solver->anchors.dim.row; idx.row++) {
+			const t_word *ptr = bitboard_row(&solver->anchors, idx.row);
+
+			for (int word = 0; word < solver->anchors.row_words; word++) {
+
+				for (t_word mask = ptr[word]; mask != 0; mask &= mask - 1) {
+					idx.col = word * WORD_BITS + __builtin_ctzll(mask);
+
+					best = max(best, solver_drop(solver, area, &solver->scratch, &piece->area, &idx));
+				}
+			}
+		}
+
+		sum += (long) (weights->removed * best + weights->fits * min(num, EVAL_FITS_MAX)) * piece->weight;
+	}
+
+	return (int) (sum / solver->total_weight);
+}
+
+/******************************************************************************
+ * The function adds a candidate to the next layer. If a candidate with the
+ * same hash exists, only the candidate with the higher value is kept. The
+ * function returns the new number of candidates.
+ *****************************************************************************/
+
+static int solver_add_child(s_solver *solver, int num, const s_solver_child *child) {
+	int pos = (int) (child->hash & solver->table_mask);
+
+	while (solver->table[pos] != 0) {
+		s_solver_child *other = &solver->children[solver->table[pos] - 1];
+
+		if (other->hash == child->hash) {
+
+			if (child->value > other->value) {
+				*other = *child;
+			}
+
+			return num;
+		}
+
+		pos = (pos + 1) & solver->table_mask;
+	}
+
+	if (num >= solver->max_children) {
+		log_exit("Too many candidates: %d", num);
+	}
+
+	solver->children[num] = *child;
+	solver->table[pos] = num + 1;
+
+	return num + 1;
+}
+
+/******************************************************************************
+ * The function adds the candidates of all drops of all home areas, that are
+ * not used by a node. The function returns the new number of candidates.
+ *****************************************************************************/
+
+static int solver_expand(s_solver *solver, const s_engine *engine, const s_solver_node *nodes, const int parent, int num) {
+	const s_solver_node *node = &nodes[parent];
+	s_solver_child child = { .parent = parent };
+
+	for (child.home_idx = 0; child.home_idx < engine->home_num; child.home_idx++) {
+		const s_engine_home *home = &engine->home[child.home_idx];
+
+		if (node->used & (1 << child.home_idx)) {
+			continue;
+		}
+
+		if (bitboard_anchors(&node->area.bits, &node->area.dim, &home->norm, &home->norm_dim, &solver->anchors) == 0) {
+			continue;
+		}
+
+		const int used = node->used | (1 << child.home_idx);
+
+		for (child.idx.row = 0; child.idx.row < solver->anchors.dim.row; child.idx.row++) {
+			const t_word *ptr = bitboard_row(&solver->anchors, child.idx.row);
+
+			for (int word = 0; word < solver->anchors.row_words; word++) {
+
+				for (t_word mask = ptr[word]; mask != 0; mask &= mask - 1) {
+					child.idx.col = word * WORD_BITS + __builtin_ctzll(mask);
+
+					child.removed = node->removed + solver_drop(solver, &node->area, &solver->scratch, &solver->drop_areas[child.home_idx], &child.idx);
+
+					child.value = solver_value(solver, &solver->scratch, child.removed);
+
+					child.hash = solver_hash(solver, &solver->scratch, used);
+
+					num = solver_add_child(solver, num, &child);
+				}
+			}
+		}
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The compare function sorts the candidates by their value in descending
+ * order. Candidates with the same value are sorted by their parent and their
+ * move, so the result does not depend on the sort algorithm.
+ *****************************************************************************/
+
+static int solver_cmp_child(const void *a, const void *b) {
+	const s_solver_child *x = a;
+	const s_solver_child *y = b;
+
+	if (x->value != y->value) {
+		return x->value > y->value ? -1 : 1;
+	}
+
+	if (x->parent != y->parent) {
+		return x->parent - y->parent;
+	}
+
+	if (x->home_idx != y->home_idx) {
+		return x->home_idx - y->home_idx;
+	}
+
+	if (x->idx.row != y->idx.row) {
+		return x->idx.row - y->idx.row;
+	}
+
+	return x->idx.col - y->idx.col;
+}
+
+/******************************************************************************
+ * The function checks if the final value of a node is the best value. The
+ * first move of the node is stored in the move struct.
+ *****************************************************************************/
+
+static void solver_offer(const s_solver_node *node, const int value, bool *found, s_eval_move *move) {
+
+	if (!*found || value > move->score) {
+		*found = true;
+
+		s_point_copy(&move->idx, &node->first.idx);
+		move->home_idx = node->first.home_idx;
+		move->removed = node->first.removed;
+		move->score = value;
+	}
+}
+
+/******************************************************************************
+ * The function searches the best move for the home areas of the engine, that
+ * are not dropped. The score of the move is the best final value of the
+ * search. The function returns false if no move is possible.
+ *
+ * (Unit tested)
+ *****************************************************************************/
+
+bool solver_best_move(s_solver *solver, const s_engine *engine, s_eval_move *move) {
+	const int all = (1 << engine->home_num) - 1;
+	bool found = false;
+
+	s_solver_node *cur = solver->layers[0];
+	s_solver_node *next = solver->layers[1];
+
+	//
+	// The root node is the game area of the engine.
+	//
+	cur[0].used = 0;
+	cur[0].removed = 0;
+	cur[0].value = 0;
+
+	for (int i = 0; i < engine->home_num; i++) {
+
+		if (engine->home[i].droped) {
+			cur[0].used |= 1 << i;
+			continue;
+		}
+
+		//
+		// Copy the home area to the drop area and normalize it.
+		//
+		const s_area *home = &engine->home[i].area;
+
+		s_point_copy(&solver->drop_areas[i].dim, &home->dim);
+
+		blocks_copy(&home->blocks, &solver->drop_areas[i].blocks, &home->dim);
+
+		s_area_normalize(&solver->drop_areas[i]);
+	}
+
+	if (cur[0].used == all) {
+		return false;
+	}
+
+	s_area_copy_deep(&engine->game_area, &cur[0].area);
+
+	int num_nodes = 1;
+
+	for (int depth = 0;; depth++) {
+		int num_children = 0;
+
+		memset(solver->table, 0, sizeof(int) * (solver->table_mask + 1));
+
+		for (int i = 0; i < num_nodes; i++) {
+
+			if (solver->cancel != NULL && atomic_load_explicit(solver->cancel, memory_order_relaxed)) {
+				log_debug_str("Search canceled!");
+				return false;
+			}
+
+			//
+			// All home areas of the node are dropped, so the node is final.
+			//
+			if (cur[i].used == all) {
+				const int expect = solver->num_pieces > 0 ? solver_expect(solver, &cur[i].area) : 0;
+
+				solver_offer(&cur[i], cur[i].value + expect, &found, move);
+				continue;
+			}
+
+			const int before = num_children;
+
+			num_children = solver_expand(solver, engine, cur, i, num_children);
+
+			//
+			// If none of the remaining home areas can be dropped, the game
+			// ends after the path to the node.
+			//
+			if (num_children == before && depth > 0) {
+				const int remaining = engine->home_num - __builtin_popcount(cur[i].used);
+
+				solver_offer(&cur[i], cur[i].value - solver->weights->no_fit * remaining, &found, move);
+			}
+		}
+
+		if (num_children == 0) {
+			break;
+		}
+
+		//
+		// Select the best candidates and create their game areas.
+		//
+		if (num_children > solver->beam) {
+			qsort(solver->children, num_children, sizeof(s_solver_child), solver_cmp_child);
+			num_children = solver->beam;
+		}
+
+		for (int i = 0; i < num_children; i++) {
+			const s_solver_child *child = &solver->children[i];
+			const s_solver_node *parent = &cur[child->parent];
+			s_solver_node *node = &next[i];
+
+			solver_drop(solver, &parent->area, &node->area, &solver->drop_areas[child->home_idx], &child->idx);
+
+			node->used = parent->used | (1 << child->home_idx);
+			node->removed = child->removed;
+			node->value = child->value;
+
+			if (depth == 0) {
+				node->first.home_idx = child->home_idx;
+				s_point_copy(&node->first.idx, &child->idx);
+				node->first.removed = child->removed;
+				node->first.score = child->value;
+
+			} else {
+				node->first = parent->first;
+			}
+		}
+
+		s_solver_node *tmp = cur;
+		cur = next;
+		next = tmp;
+
+		num_nodes = num_children;
+	}
+
+	if (found) {
+		log_debug("Best move - home: %d idx: %d/%d score: %d", move->home_idx, move->idx.row, move->idx.col, move->score);
+	}
+
+	return found;
+}
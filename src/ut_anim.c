@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "anim.h"
+
+/******************************************************************************
+ * The function checks the deadlines and timeouts of the frames.
+ *****************************************************************************/
+
+static void test_anim_frames() {
+	s_anim anim;
+
+	anim_init(&anim, 200);
+
+	ut_check_bool(anim_is_running(&anim), false, "idle");
+	ut_check_bool(anim_is_due(&anim, 1000), false, "idle due");
+	ut_check_int(anim_timeout(&anim, 1000), -1, "idle timeout");
+
+	anim_start(&anim, ANIM_MOVE, 1000);
+
+	ut_check_bool(anim_is_running(&anim), true, "running");
+	ut_check_bool(anim_is_due(&anim, 1000), false, "start");
+	ut_check_int(anim_timeout(&anim, 1000), 200, "start timeout");
+
+	ut_check_bool(anim_is_due(&anim, 1150), false, "before");
+	ut_check_int(anim_timeout(&anim, 1150), 50, "before timeout");
+
+	ut_check_bool(anim_is_due(&anim, 1200), true, "deadline");
+	ut_check_int(anim_timeout(&anim, 1250), 0, "after timeout");
+
+	//
+	// The next frame starts at the time, when the previous was played.
+	//
+	anim_start(&anim, ANIM_DROP, 1250);
+
+	ut_check_int(anim.state, ANIM_DROP, "next");
+	ut_check_int(anim_timeout(&anim, 1250), 200, "next timeout");
+
+	anim_stop(&anim);
+
+	ut_check_bool(anim_is_running(&anim), false, "stopped");
+	ut_check_int(anim_timeout(&anim, 1250), -1, "stopped timeout");
+}
+
+/******************************************************************************
+ * The function checks that without a delay, the frames are due immediately.
+ *****************************************************************************/
+
+static void test_anim_no_delay() {
+	s_anim anim;
+
+	anim_init(&anim, 0);
+
+	anim_start(&anim, ANIM_DROP, 1000);
+
+	ut_check_bool(anim_is_due(&anim, 1000), true, "due");
+	ut_check_int(anim_timeout(&anim, 1000), 0, "timeout");
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_anim_exec() {
+
+	test_anim_frames();
+
+	test_anim_no_delay();
+}
@@ -0,0 +1,276 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ut_utils.h"
+#include "bitboard.h"
+#include "s_area.h"
+#include "colors.h"
+
+/******************************************************************************
+ * The function checks the conversion of blocks to a bitboard with more than
+ * one word per row.
+ *****************************************************************************/
+
+static void test_bitboard_from_blocks() {
+	s_blocks blocks;
+	s_bitboard bb;
+
+	const s_point dim = { 2, WORD_BITS + 2 };
+
+	blocks_create(&blocks, dim.row, dim.col);
+	blocks_set(&blocks, &dim, CLR_NONE);
+
+	bitboard_create(&bb, dim.row, dim.col);
+	ut_check_int(bb.row_words, 2, "row words");
+
+	blocks_at(&blocks, 0, 0) = CLR_RED__N;
+	blocks_at(&blocks, 0, WORD_BITS) = CLR_RED__N;
+	blocks_at(&blocks, 1, WORD_BITS + 1) = CLR_RED__N;
+
+	bitboard_from_blocks(&bb, &blocks, &dim);
+
+	for (int row = 0; row < dim.row; row++) {
+		for (int col = 0; col < dim.col; col++) {
+			ut_check_bool(bitboard_is_set(&bb, row, col), blocks_at(&blocks, row, col) != CLR_NONE, "bit");
+		}
+	}
+
+	bitboard_unset(&bb, 0, WORD_BITS);
+	ut_check_bool(bitboard_is_set(&bb, 0, WORD_BITS), false, "unset");
+
+	bitboard_free(&bb);
+	blocks_free(&blocks);
+}
+
+/******************************************************************************
+ * The function checks the placement of a row mask, which spans two words.
+ *****************************************************************************/
+
+static void test_bitboard_row_fits() {
+	s_bitboard bb;
+
+	bitboard_create(&bb, 1, WORD_BITS * 2);
+
+	bitboard_set(&bb, 0, WORD_BITS + 1);
+
+	//
+	// Mask: 101 at column WORD_BITS - 1 covers the bits WORD_BITS - 1 and
+	// WORD_BITS + 1.
+	//
+	ut_check_bool(bitboard_row_fits(&bb, 0, WORD_BITS - 1, 5), false, "spill collides");
+
+	//
+	// Mask: 101 at column WORD_BITS - 2 covers the bits WORD_BITS - 2 and
+	// WORD_BITS.
+	//
+	ut_check_bool(bitboard_row_fits(&bb, 0, WORD_BITS - 2, 5), true, "spill fits");
+
+	ut_check_bool(bitboard_row_fits(&bb, 0, WORD_BITS + 1, 1), false, "second word");
+
+	ut_check_bool(bitboard_row_fits(&bb, 0, 0, 1), true, "first word");
+
+	bitboard_free(&bb);
+}
+
+/******************************************************************************
+ * The function checks the dropping of an area with the bitboards.
+ *
+ * area:  drop:
+ * --X    XX
+ * ---    -X
+ * ---
+ *****************************************************************************/
+
+static void test_s_area_drop() {
+	s_area area, drop;
+
+	s_area_create(&area, &(s_point ) { 3, 3 }, &(s_point ) { 1, 1 });
+	s_area_set_blocks(&area, CLR_NONE);
+
+	s_area_block(&area, 0, 2) = CLR_RED__N;
+	s_area_sync(&area);
+
+	s_area_create(&drop, &(s_point ) { 2, 2 }, &(s_point ) { 1, 1 });
+	s_area_set_blocks(&drop, CLR_BLUE_N);
+
+	s_area_block(&drop, 1, 0) = CLR_NONE;
+	s_area_sync(&drop);
+
+	ut_check_bool(s_area_drop(&area, &(s_point ) { 0, 1 }, &drop, false), false, "collision");
+
+	ut_check_bool(s_area_drop(&area, &(s_point ) { 1, 1 }, &drop, true), true, "drop");
+
+	//
+	// The dropped blocks have to be set in the bitboard.
+	//
+	ut_check_bool(bitboard_is_set(&area.bits, 1, 1), true, "bit 1/1");
+	ut_check_bool(bitboard_is_set(&area.bits, 1, 2), true, "bit 1/2");
+	ut_check_bool(bitboard_is_set(&area.bits, 2, 1), false, "bit 2/1");
+	ut_check_bool(bitboard_is_set(&area.bits, 2, 2), true, "bit 2/2");
+
+	ut_check_int(s_area_block(&area, 2, 2), CLR_BLUE_N, "block 2/2");
+
+	ut_check_bool(s_area_drop(&area, &(s_point ) { 0, 0 }, &drop, false), false, "occupied");
+
+	s_area_free(&area);
+	s_area_free(&drop);
+}
+
+/******************************************************************************
+ * The function checks the legal anchors of a shape against the block by block
+ * check of s_area_drop(). The area has more than one word per row, so the
+ * shifting between words is also checked.
+ *
+ * shape:
+ * X-X
+ * -X-
+ *****************************************************************************/
+
+static void test_bitboard_anchors() {
+	s_area area, drop;
+	s_bitboard anchors;
+	s_point idx;
+
+	const s_point dim = { 4, WORD_BITS + 5 };
+
+	s_area_create(&area, &dim, &(s_point ) { 1, 1 });
+	s_area_set_blocks(&area, CLR_NONE);
+
+	bitboard_create(&anchors, dim.row, dim.col);
+
+	//
+	// Fill the area with a pattern.
+	//
+	for (int row = 0; row < dim.row; row++) {
+		for (int col = 0; col < dim.col; col++) {
+			if ((row * 7 + col * 3) % 5 == 0) {
+				s_area_block(&area, row, col) = CLR_RED__N;
+			}
+		}
+	}
+	s_area_sync(&area);
+
+	s_area_create(&drop, &(s_point ) { 2, 3 }, &(s_point ) { 1, 1 });
+	s_area_set_blocks(&drop, CLR_NONE);
+
+	s_area_block(&drop, 0, 0) = CLR_BLUE_N;
+	s_area_block(&drop, 0, 2) = CLR_BLUE_N;
+	s_area_block(&drop, 1, 1) = CLR_BLUE_N;
+	s_area_sync(&drop);
+
+	const int num = s_area_legal_anchors(&area, &drop, &anchors);
+
+	int expected = 0;
+
+	for (idx.row = 0; idx.row < dim.row; idx.row++) {
+		for (idx.col = 0; idx.col < dim.col; idx.col++) {
+
+			const bool legal = idx.row <= dim.row - drop.dim.row && idx.col <= dim.col - drop.dim.col && s_area_drop(&area, &idx, &drop, false);
+
+			ut_check_bool(bitboard_is_set(&anchors, idx.row, idx.col), legal, "anchor");
+
+			if (legal) {
+				expected++;
+			}
+		}
+	}
+
+	ut_check_int(num, expected, "num anchors");
+
+	//
+	// The first anchor is the first legal position.
+	//
+	ut_check_bool(s_area_can_drop_anywhere(&area, &drop, &anchors, &idx), true, "can drop");
+	ut_check_bool(s_area_drop(&area, &idx, &drop, false), true, "first anchor");
+
+	//
+	// On a full area there is no legal anchor.
+	//
+	s_area_set_blocks(&area, CLR_RED__N);
+
+	ut_check_int(s_area_legal_anchors(&area, &drop, &anchors), 0, "full");
+	ut_check_bool(bitboard_first(&anchors, &idx), false, "no first");
+
+	bitboard_free(&anchors);
+
+	s_area_free(&area);
+	s_area_free(&drop);
+}
+
+/******************************************************************************
+ * The function checks the normalization of a bitboard.
+ *
+ * -----    x-x--
+ * --x-x => -x---
+ * ---x-    -----
+ *****************************************************************************/
+
+static void test_bitboard_normalize() {
+	s_bitboard bb;
+	s_point norm_dim;
+
+	const s_point dim = { 3, 5 };
+
+	bitboard_create(&bb, dim.row, dim.col);
+
+	bitboard_set(&bb, 1, 2);
+	bitboard_set(&bb, 1, 4);
+	bitboard_set(&bb, 2, 3);
+
+	bitboard_normalize(&bb, &dim, &norm_dim);
+
+	ut_check_s_point(&norm_dim, &(s_point ) { 2, 3 }, "norm dim");
+
+	ut_check_int((int) bitboard_row(&bb, 0)[0], 5, "row 0");
+	ut_check_int((int) bitboard_row(&bb, 1)[0], 2, "row 1");
+	ut_check_int((int) bitboard_row(&bb, 2)[0], 0, "row 2");
+
+	//
+	// An empty bitboard has no dimension.
+	//
+	bitboard_clear(&bb);
+	bitboard_normalize(&bb, &dim, &norm_dim);
+
+	ut_check_s_point(&norm_dim, &(s_point ) { 0, 0 }, "empty");
+
+	bitboard_free(&bb);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_bitboard_exec() {
+
+	test_bitboard_from_blocks();
+
+	test_bitboard_row_fits();
+
+	test_s_area_drop();
+
+	test_bitboard_anchors();
+
+	test_bitboard_normalize();
+}
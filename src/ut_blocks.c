@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "ut_utils.h"
+#include "blocks_simd.h"
+#include "colors.h"
+
+/******************************************************************************
+ * The maximum number of blocks of the rows, that are tested. It is larger
+ * than the number of blocks of a vector, so that all code paths (vector and
+ * tail) are used.
+ *****************************************************************************/
+
+#define UT_ROW_MAX 64
+
+/******************************************************************************
+ * The function fills a row with a pattern, which has empty blocks at
+ * different positions, depending on the seed.
+ *****************************************************************************/
+
+static void ut_blocks_pattern(t_block *row, const int num, const int seed) {
+
+	for (int i = 0; i < num; i++) {
+		row[i] = (i * 7 + seed) % 5 == 0 ? CLR_NONE : (i + seed) % 4 + 1;
+	}
+}
+
+/******************************************************************************
+ * The function checks the mask kernels for all row lengths against a simple
+ * loop. The rows start at an unaligned address.
+ *****************************************************************************/
+
+static void test_blocks_row_mask() {
+	t_block buf[UT_ROW_MAX + 1];
+	t_block *row = &buf[1];
+
+	log_debug("Kernels: %s", blocks_simd_name());
+
+	for (int num = 0; num <= UT_ROW_MAX; num++) {
+
+		ut_blocks_pattern(row, num, num);
+
+		uint64_t mask = 0;
+
+		for (int i = 0; i < num; i++) {
+			if (row[i] != CLR_NONE) {
+				mask |= (uint64_t) 1 << i;
+			}
+		}
+
+		ut_check_bool(blocks_row_mask(row, num) == mask, true, "mask");
+	}
+
+	//
+	// A full row has all bits set.
+	//
+	blocks_row_fill(row, CLR_RED__N, UT_ROW_MAX);
+
+	ut_check_bool(blocks_row_mask(row, UT_ROW_MAX) == UINT64_MAX, true, "full mask");
+}
+
+/******************************************************************************
+ * The function checks the fill kernels. The blocks behind the row must not be
+ * changed.
+ *****************************************************************************/
+
+static void test_blocks_row_fill() {
+	t_block to[UT_ROW_MAX + 1];
+
+	for (int num = 0; num < UT_ROW_MAX; num++) {
+
+		to[num] = CLR_YELL_N;
+		blocks_row_fill(to, CLR_BLUE_N, num);
+
+		for (int i = 0; i < num; i++) {
+			ut_check_int(to[i], CLR_BLUE_N, "fill");
+		}
+		ut_check_int(to[num], CLR_YELL_N, "fill end");
+	}
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_blocks_exec() {
+
+	const char *names[] = { "scalar", "sse2", "avx2" };
+
+	//
+	// Remember the kernels, that were selected for the cpu.
+	//
+	const char *selected = blocks_simd_name();
+
+	for (int i = 0; i < 3; i++) {
+
+		if (!blocks_simd_use(names[i])) {
+			log_debug("Kernels not supported: %s", names[i]);
+			continue;
+		}
+
+		test_blocks_row_mask();
+
+		test_blocks_row_fill();
+	}
+
+	blocks_simd_use(selected);
+}
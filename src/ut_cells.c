@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "cells.h"
+
+/******************************************************************************
+ * The function checks the setting of cells and strings.
+ *****************************************************************************/
+
+static void test_cells_set() {
+	s_cells cells;
+
+	cells_create(&cells, 3, 4, 7);
+
+	ut_check_bool(cells_get(&cells, 2, 3)->chr == L' ', true, "clear chr");
+	ut_check_int(cells_get(&cells, 2, 3)->attr, 7, "clear attr");
+
+	cells_set(&cells, 1, 2, L'x', 3);
+
+	ut_check_bool(cells_get(&cells, 1, 2)->chr == L'x', true, "set chr");
+	ut_check_int(cells_get(&cells, 1, 2)->attr, 3, "set attr");
+
+	//
+	// The string is cut at the end of the row.
+	//
+	cells_set_str(&cells, 0, 2, L"abc", 5);
+
+	ut_check_bool(cells_get(&cells, 0, 2)->chr == L'a', true, "str 0");
+	ut_check_bool(cells_get(&cells, 0, 3)->chr == L'b', true, "str 1");
+	ut_check_bool(cells_get(&cells, 1, 0)->chr == L' ', true, "str cut");
+
+	//
+	// Cells outside the buffer are ignored.
+	//
+	cells_set(&cells, -1, 0, L'x', 3);
+	cells_set(&cells, 0, 4, L'x', 3);
+	cells_set(&cells, 3, 0, L'x', 3);
+
+	cells_resize(&cells, 2, 2);
+
+	ut_check_bool(cells_get(&cells, 1, 1)->chr == L' ', true, "resize");
+
+	cells_free(&cells);
+}
+
+/******************************************************************************
+ * The function checks the copying of a layer.
+ *****************************************************************************/
+
+static void test_cells_copy() {
+	s_cells layer;
+	s_cells cells;
+
+	cells_create(&layer, 2, 3, 0);
+	cells_create(&cells, 2, 3, 0);
+
+	cells_set(&layer, 1, 2, L'x', 3);
+	cells_set(&cells, 0, 0, L'y', 4);
+
+	cells_copy(&cells, &layer);
+
+	ut_check_bool(cells_get(&cells, 1, 2)->chr == L'x', true, "copy chr");
+	ut_check_int(cells_get(&cells, 1, 2)->attr, 3, "copy attr");
+	ut_check_bool(cells_get(&cells, 0, 0)->chr == L' ', true, "overwritten");
+
+	//
+	// The layer is unchanged by changes of the copy.
+	//
+	cells_set(&cells, 1, 2, L'z', 5);
+
+	ut_check_bool(cells_get(&layer, 1, 2)->chr == L'x', true, "layer");
+
+	cells_free(&cells);
+	cells_free(&layer);
+}
+
+/******************************************************************************
+ * The function checks the computation of the runs of changed cells.
+ *****************************************************************************/
+
+static void test_cells_next_run() {
+	s_cells cells;
+	int start, end;
+
+	cells_create(&cells, 2, 6, 0);
+
+	//
+	// After the invalidation, each row is a run.
+	//
+	start = 0;
+	ut_check_bool(cells_next_run(&cells, 1, &start, &end), true, "invalid");
+	ut_check_int(start, 0, "invalid start");
+	ut_check_int(end, 6, "invalid end");
+
+	//
+	// Mark the current frame as flushed.
+	//
+	memcpy(cells.prev, cells.cur, sizeof(s_cell) * 2 * 6);
+
+	start = 0;
+	ut_check_bool(cells_next_run(&cells, 1, &start, &end), false, "unchanged");
+
+	//
+	// Two runs, one with a changed character, one with a changed attribute.
+	//
+	cells_set(&cells, 1, 1, L'x', 0);
+	cells_set(&cells, 1, 2, L'x', 0);
+	cells_set(&cells, 1, 5, L' ', 1);
+
+	start = 0;
+	ut_check_bool(cells_next_run(&cells, 1, &start, &end), true, "run 1");
+	ut_check_int(start, 1, "run 1 start");
+	ut_check_int(end, 3, "run 1 end");
+
+	start = end;
+	ut_check_bool(cells_next_run(&cells, 1, &start, &end), true, "run 2");
+	ut_check_int(start, 5, "run 2 start");
+	ut_check_int(end, 6, "run 2 end");
+
+	start = end;
+	ut_check_bool(cells_next_run(&cells, 1, &start, &end), false, "no run");
+
+	//
+	// Setting the same cell again is not a change.
+	//
+	start = 0;
+	ut_check_bool(cells_next_run(&cells, 0, &start, &end), false, "row 0");
+
+	cells_free(&cells);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_cells_exec() {
+
+	test_cells_set();
+
+	test_cells_copy();
+
+	test_cells_next_run();
+}
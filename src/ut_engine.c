@@ -0,0 +1,240 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "engine.h"
+#include "rules.h"
+#include "init_random_colors.h"
+
+/******************************************************************************
+ * The game area has 2 rows and 2 columns, so two single blocks complete a
+ * line. The block of a home area is not in the upper left corner, so the
+ * normalization is necessary.
+ *****************************************************************************/
+
+static const s_point _game_dim = { 2, 2 };
+
+static const s_point _block = { 1, 1 };
+
+/******************************************************************************
+ * The function checks legal and illegal moves, the removing of lines and the
+ * refilling of the home areas.
+ *****************************************************************************/
+
+static void test_engine_apply_move() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	ut_check_int(engine.score, 0, "score");
+	ut_check_int(engine.turns, 0, "turns");
+	ut_check_bool(engine_is_end(&engine), false, "end");
+
+	//
+	// The normalized block is dropped at the upper left corner.
+	//
+	ut_check_int(engine_apply_move(&engine, 0, &(s_point ) { 0, 0 }), 0, "move 1");
+	ut_check_int(s_area_block(&engine.game_area, 0, 0), CLR_RED__N, "move 1 block");
+	ut_check_int(engine.turns, 1, "move 1 turns");
+	ut_check_bool(engine.home[0].droped, true, "move 1 dropped");
+
+	//
+	// Illegal moves: dropped home area, occupied block, outside and unknown
+	// home area.
+	//
+	ut_check_int(engine_apply_move(&engine, 0, &(s_point ) { 1, 1 }), ENGINE_ILLEGAL, "dropped");
+	ut_check_int(engine_apply_move(&engine, 1, &(s_point ) { 0, 0 }), ENGINE_ILLEGAL, "occupied");
+	ut_check_int(engine_apply_move(&engine, 1, &(s_point ) { 2, 0 }), ENGINE_ILLEGAL, "outside");
+	ut_check_int(engine_apply_move(&engine, 2, &(s_point ) { 1, 1 }), ENGINE_ILLEGAL, "home idx");
+	ut_check_int(engine.turns, 1, "illegal turns");
+
+	//
+	// The second block completes the first row, which is removed. All home
+	// areas are dropped, so they are refilled.
+	//
+	ut_check_int(engine_apply_move(&engine, 1, &(s_point ) { 0, 1 }), 2, "move 2");
+	ut_check_int(s_area_block(&engine.game_area, 0, 0), CLR_NONE, "move 2 block");
+	ut_check_int(engine.score, 2, "move 2 score");
+	ut_check_bool(engine.home[0].droped, false, "refill 0");
+	ut_check_bool(engine.home[1].droped, false, "refill 1");
+	ut_check_bool(engine_is_end(&engine), false, "move 2 end");
+
+	//
+	// Reset the game.
+	//
+	engine_reset(&engine, UT_SEED);
+
+	ut_check_int(engine.score, 0, "reset score");
+	ut_check_int(engine.turns, 0, "reset turns");
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function checks the detection of the end of a game.
+ *****************************************************************************/
+
+static void test_engine_end() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+	s_point idx;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, ut_rules_keep);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	ut_check_int(engine_home_anchors(&engine, 0, &engine.anchors), 4, "anchors");
+
+	//
+	// Fill the game area.
+	//
+	for (idx.row = 0; idx.row < _game_dim.row; idx.row++) {
+		for (idx.col = 0; idx.col < _game_dim.col; idx.col++) {
+
+			ut_check_bool(engine_is_end(&engine), false, "not end");
+
+			ut_check_int(engine_apply_move(&engine, idx.col, &idx), 0, "move");
+		}
+	}
+
+	ut_check_bool(engine_is_end(&engine), true, "end");
+	ut_check_int(engine.turns, 4, "turns");
+	ut_check_int(engine_home_anchors(&engine, 0, &engine.anchors), 0, "no anchors");
+
+	//
+	// After the end, no move is possible.
+	//
+	ut_check_int(engine_apply_move(&engine, 0, &(s_point ) { 0, 0 }), ENGINE_ILLEGAL, "after end");
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function checks that two games can be played at the same time, without
+ * influencing each other.
+ *****************************************************************************/
+
+static void test_engine_two_games() {
+	s_game_cfg game_cfg;
+	s_engine engine_1, engine_2;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine_1, &game_cfg, UT_SEED);
+	engine_create(&engine_2, &game_cfg, UT_SEED);
+
+	ut_check_int(engine_apply_move(&engine_1, 0, &(s_point ) { 0, 0 }), 0, "game 1 move 1");
+	ut_check_int(engine_apply_move(&engine_2, 0, &(s_point ) { 1, 1 }), 0, "game 2 move 1");
+
+	//
+	// The second move completes a line only on the first game.
+	//
+	ut_check_int(engine_apply_move(&engine_1, 1, &(s_point ) { 0, 1 }), 2, "game 1 move 2");
+	ut_check_int(engine_apply_move(&engine_2, 1, &(s_point ) { 0, 0 }), 0, "game 2 move 2");
+
+	ut_check_int(engine_1.score, 2, "game 1 score");
+	ut_check_int(engine_2.score, 0, "game 2 score");
+
+	ut_check_int(s_area_block(&engine_2.game_area, 1, 1), CLR_RED__N, "game 2 block");
+
+	engine_free(&engine_1);
+
+	//
+	// The third move completes a row and a column of the second game.
+	//
+	ut_check_int(engine_apply_move(&engine_2, 0, &(s_point ) { 1, 0 }), 3, "game 2 move 3");
+
+	engine_free(&engine_2);
+}
+
+/******************************************************************************
+ * The function compares the blocks of the home areas of two engines.
+ *****************************************************************************/
+
+static bool ut_same_homes(const s_engine *engine_1, const s_engine *engine_2) {
+
+	for (int i = 0; i < engine_1->home_num; i++) {
+		for (int row = 0; row < engine_1->home[i].area.dim.row; row++) {
+			for (int col = 0; col < engine_1->home[i].area.dim.col; col++) {
+
+				if (s_area_block(&engine_1->home[i].area, row, col) != s_area_block(&engine_2->home[i].area, row, col)) {
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * The function checks that a game is reproducible by its seed.
+ *****************************************************************************/
+
+static void test_engine_seed() {
+	s_game_cfg game_cfg;
+	s_engine engine_1, engine_2;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_neighbors);
+
+	s_point_set(&game_cfg.drop_dim, 4, 4);
+	s_point_set(&game_cfg.game_dim, 8, 8);
+	strncpy(game_cfg.data, "30", SIZE_DATA);
+
+	game_cfg.fct_ptr_set_data = init_random_colors_setup;
+	game_cfg.fct_ptr_init_random = init_random_colors;
+
+	engine_create(&engine_1, &game_cfg, 7);
+	engine_create(&engine_2, &game_cfg, 7);
+
+	ut_check_int(engine_1.seed, 7, "seed");
+	ut_check_bool(ut_same_homes(&engine_1, &engine_2), true, "same seed");
+
+	engine_reset(&engine_2, 8);
+	ut_check_bool(ut_same_homes(&engine_1, &engine_2), false, "other seed");
+
+	engine_reset(&engine_2, 7);
+	ut_check_bool(ut_same_homes(&engine_1, &engine_2), true, "reset seed");
+
+	engine_free(&engine_1);
+	engine_free(&engine_2);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_engine_exec() {
+
+	test_engine_apply_move();
+
+	test_engine_end();
+
+	test_engine_two_games();
+
+	test_engine_seed();
+}
@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "eval.h"
+#include "rules.h"
+
+/******************************************************************************
+ * The game area has 3 rows and 3 columns and the home areas are single
+ * blocks.
+ *****************************************************************************/
+
+static const s_point _game_dim = { 3, 3 };
+
+static const s_point _block = { 0, 0 };
+
+/******************************************************************************
+ * The function checks the holes of a bitboard. The second bitboard has two
+ * words per row.
+ *****************************************************************************/
+
+static void test_eval_holes() {
+	s_bitboard bb;
+
+	bitboard_create(&bb, 3, 3);
+
+	ut_check_int(eval_holes(&bb, &bb.dim), 0, "empty");
+
+	bitboard_set(&bb, 0, 1);
+	bitboard_set(&bb, 1, 0);
+
+	ut_check_int(eval_holes(&bb, &bb.dim), 1, "corner");
+
+	bitboard_set(&bb, 1, 2);
+	bitboard_set(&bb, 2, 1);
+
+	ut_check_int(eval_holes(&bb, &bb.dim), 5, "corners and center");
+
+	bitboard_free(&bb);
+
+	bitboard_create(&bb, 1, 70);
+
+	bitboard_set(&bb, 0, 63);
+	bitboard_set(&bb, 0, 65);
+	bitboard_set(&bb, 0, 68);
+
+	ut_check_int(eval_holes(&bb, &bb.dim), 2, "words");
+
+	bitboard_free(&bb);
+}
+
+/******************************************************************************
+ * The function checks the transitions of a bitboard.
+ *****************************************************************************/
+
+static void test_eval_transitions() {
+	s_bitboard bb;
+
+	bitboard_create(&bb, 3, 3);
+
+	ut_check_int(eval_transitions(&bb, &bb.dim), 0, "empty");
+
+	bitboard_set(&bb, 1, 1);
+
+	ut_check_int(eval_transitions(&bb, &bb.dim), 4, "center");
+
+	bitboard_set(&bb, 0, 2);
+
+	ut_check_int(eval_transitions(&bb, &bb.dim), 6, "corner");
+
+	bitboard_free(&bb);
+
+	bitboard_create(&bb, 2, 70);
+
+	bitboard_set(&bb, 0, 63);
+
+	ut_check_int(eval_transitions(&bb, &bb.dim), 3, "words");
+
+	bitboard_set(&bb, 0, 69);
+
+	ut_check_int(eval_transitions(&bb, &bb.dim), 5, "last column");
+
+	bitboard_free(&bb);
+}
+
+/******************************************************************************
+ * The function checks the best moves of the greedy and the default weights.
+ * With a block in the center, the greedy evaluation selects the first legal
+ * position, while the default weights select a position next to the center,
+ * which has the fewest transitions.
+ *****************************************************************************/
+
+static void test_eval_best_move() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+	s_eval eval;
+	s_eval_move move;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	eval_create(&eval, &game_cfg);
+
+	engine_apply_move(&engine, 0, &(s_point ) { 1, 1 });
+
+	ut_check_bool(eval_best_move(&eval, &engine, &eval_weights_greedy, &move), true, "greedy found");
+	ut_check_int(move.home_idx, 1, "greedy home");
+	ut_check_s_point(&move.idx, &(s_point ) { 0, 0 }, "greedy idx");
+	ut_check_int(move.score, 0, "greedy score");
+
+	ut_check_bool(eval_best_move(&eval, &engine, &eval_weights_default, &move), true, "default found");
+	ut_check_s_point(&move.idx, &(s_point ) { 0, 1 }, "default idx");
+	ut_check_int(move.score, -5 * eval_weights_default.transitions, "default score");
+
+	//
+	// The next move completes the middle column.
+	//
+	engine_apply_move(&engine, 1, &(s_point ) { 0, 1 });
+
+	ut_check_bool(eval_best_move(&eval, &engine, &eval_weights_greedy, &move), true, "line found");
+	ut_check_s_point(&move.idx, &(s_point ) { 2, 1 }, "line idx");
+	ut_check_int(move.removed, 3, "line removed");
+
+	eval_free(&eval);
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_eval_exec() {
+
+	test_eval_holes();
+
+	test_eval_transitions();
+
+	test_eval_best_move();
+}
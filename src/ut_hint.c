@@ -0,0 +1,194 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "ut_utils.h"
+#include "hint.h"
+#include "rules.h"
+
+/******************************************************************************
+ * The game area has 2 rows and 2 columns.
+ *****************************************************************************/
+
+static const s_point _game_dim = { 2, 2 };
+
+static const s_point _block = { 0, 0 };
+
+//
+// The maximum time to wait for a result in milliseconds.
+//
+#define UT_WAIT_MS 5000
+
+/******************************************************************************
+ * The function waits for the eventfd of the hint until the search is
+ * finished.
+ *****************************************************************************/
+
+static e_hint_state ut_wait(s_hint *hint, s_eval_move *move) {
+	struct pollfd pfd = { .fd = hint->fd, .events = POLLIN };
+	e_hint_state state;
+
+	while ((state = hint_get(hint, move)) == HINT_SEARCHING) {
+
+		ut_check_int(poll(&pfd, 1, UT_WAIT_MS), 1, "poll");
+
+		uint64_t count;
+		ut_check_bool(read(hint->fd, &count, sizeof(count)) == sizeof(count), true, "read");
+	}
+
+	return state;
+}
+
+/******************************************************************************
+ * The function checks the result of the hint against the solver, that is
+ * called directly with the same parameters.
+ *****************************************************************************/
+
+static void ut_check_hint(s_hint *hint, const s_engine *engine, const char *msg) {
+	s_solver solver;
+	s_eval_move expected;
+	s_eval_move move;
+
+	solver_create(&solver, engine, &eval_weights_default, SOLVER_BEAM_DEFAULT, true);
+
+	const bool found = solver_best_move(&solver, engine, &expected);
+
+	solver_free(&solver);
+
+	const e_hint_state state = ut_wait(hint, &move);
+
+	ut_check_int(state, found ? HINT_READY : HINT_NONE, msg);
+
+	if (found) {
+		ut_check_int(move.home_idx, expected.home_idx, msg);
+		ut_check_int(move.idx.row, expected.idx.row, msg);
+		ut_check_int(move.idx.col, expected.idx.col, msg);
+		ut_check_int(move.score, expected.score, msg);
+	}
+}
+
+/******************************************************************************
+ * The function checks that a hint, that was never created, can be freed. This
+ * happens if the program exits before the first game was started. A hint can
+ * also be freed twice.
+ *****************************************************************************/
+
+static void test_hint_free() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+	s_hint hint = { .started = false };
+
+	hint_free(&hint);
+
+	ut_check_bool(hint.started, false, "not created");
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	hint_create(&hint, &engine);
+
+	ut_check_bool(hint.started, true, "created");
+
+	hint_free(&hint);
+
+	hint_free(&hint);
+
+	ut_check_bool(hint.started, false, "freed");
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function checks that the hint follows the requests. The game area
+ * contains a block in the lower left corner and the home areas are single
+ * blocks. After each request the result of the previous game is outdated.
+ *****************************************************************************/
+
+static void test_hint_request() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+	s_hint hint;
+	s_eval_move move;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	s_area_block(&engine.game_area, 1, 0) = CLR_RED__N;
+	s_area_sync(&engine.game_area);
+
+	hint_create(&hint, &engine);
+
+	hint_request(&hint, &engine);
+
+	ut_check_hint(&hint, &engine, "first");
+
+	//
+	// Apply the move and request the next hint. The result of the previous
+	// request is outdated, so only the new result is accepted.
+	//
+	ut_check_int(hint_get(&hint, &move), HINT_READY, "ready");
+
+	ut_check_bool(engine_apply_move(&engine, move.home_idx, &move.idx) != ENGINE_ILLEGAL, true, "apply");
+
+	hint_request(&hint, &engine);
+
+	ut_check_int(hint.gen, 2, "generation");
+
+	ut_check_hint(&hint, &engine, "second");
+
+	//
+	// A picked up home area is copied from its backup.
+	//
+	const int idx = engine.home[0].droped ? 1 : 0;
+
+	engine.pickup_idx = idx;
+	blocks_copy(&engine.home[idx].area.blocks, &engine.backup.blocks, &engine.home[idx].area.dim);
+	s_area_set_blocks(&engine.home[idx].area, CLR_NONE);
+
+	hint_request(&hint, &engine);
+
+	ut_check_int(ut_wait(&hint, &move), HINT_READY, "pickup");
+
+	ut_check_int(hint.engine.pickup_idx, ENGINE_PICKUP_UNDEF, "pickup undef");
+	ut_check_int(s_area_block(&hint.engine.home[idx].area, 0, 0), CLR_RED__N, "pickup copy");
+
+	hint_free(&hint);
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_hint_exec() {
+
+	test_hint_free();
+
+	test_hint_request();
+}
@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "ut_utils.h"
+#include "loop.h"
+
+/******************************************************************************
+ * The time to wait for the timer in micro seconds.
+ *****************************************************************************/
+
+#define UT_WAIT_USEC 5000
+
+/******************************************************************************
+ * The function checks that the timer, the worker and the signals wake the
+ * loop. The input of the unit tests may always be readable, so only the
+ * expected flag is checked.
+ *****************************************************************************/
+
+static void test_loop_wait() {
+	s_loop loop;
+
+	loop_create(&loop);
+
+	//
+	// Timer
+	//
+	loop_set_timer(&loop, 1);
+
+	usleep(UT_WAIT_USEC);
+
+	ut_check_bool(loop_wait(&loop, -1) & LOOP_TIMER, true, "timer");
+
+	//
+	// A disarmed timer does not expire.
+	//
+	loop_set_timer(&loop, 1);
+	loop_set_timer(&loop, -1);
+
+	usleep(UT_WAIT_USEC);
+
+	kill(getpid(), SIGWINCH);
+
+	ut_check_bool(loop_wait(&loop, -1) & LOOP_TIMER, false, "disarmed");
+
+	//
+	// Worker
+	//
+	const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	const uint64_t one = 1;
+
+	ut_check_bool(write(fd, &one, sizeof(one)) == sizeof(one), true, "write");
+
+	ut_check_bool(loop_wait(&loop, fd) & LOOP_WORKER, true, "worker");
+
+	close(fd);
+
+	//
+	// Signals
+	//
+	kill(getpid(), SIGWINCH);
+
+	ut_check_bool(loop_wait(&loop, -1) & LOOP_RESIZE, true, "resize");
+
+	kill(getpid(), SIGTERM);
+
+	ut_check_bool(loop_wait(&loop, -1) & LOOP_TERM, true, "term");
+
+	loop_free(&loop);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_loop_exec() {
+
+	test_loop_wait();
+}
@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "regions.h"
+
+/******************************************************************************
+ * The function checks the region of a pixel.
+ *****************************************************************************/
+
+static void check_region(const s_regions *regions, const int row, const int col, const e_region_type type, const int idx, const int block_row, const int block_col, const char *msg) {
+
+	const s_region *region = regions_get(regions, &(s_point ) { row, col });
+
+	ut_check_int(region->type, type, msg);
+	ut_check_int(region->idx, idx, msg);
+	ut_check_s_point(&region->block, &(s_point ) { block_row, block_col }, msg);
+}
+
+/******************************************************************************
+ * The function checks the building of the region map with areas and a
+ * rectangle.
+ *****************************************************************************/
+
+static void test_regions() {
+	s_regions regions = { .dim = { 0, 0 }, .map = NULL };
+	s_area area;
+
+	//
+	// An area with 2x3 blocks, each with 1x2 pixels at the position 1/1.
+	//
+	s_area_create(&area, &(s_point ) { 2, 3 }, &(s_point ) { 1, 2 });
+	s_point_set(&area.pos, 1, 1);
+
+	regions_reset(&regions, &(s_point ) { 4, 8 });
+
+	check_region(&regions, 0, 0, REGION_BG, -1, 0, 0, "reset");
+
+	regions_add_area(&regions, REGION_HOME, 2, &area);
+
+	check_region(&regions, 0, 1, REGION_BG, -1, 0, 0, "above");
+	check_region(&regions, 1, 1, REGION_HOME, 2, 0, 0, "ul");
+	check_region(&regions, 1, 2, REGION_HOME, 2, 0, 0, "ul 2");
+	check_region(&regions, 1, 3, REGION_HOME, 2, 0, 1, "block 1");
+	check_region(&regions, 2, 6, REGION_HOME, 2, 1, 2, "lr");
+	check_region(&regions, 2, 7, REGION_BG, -1, 0, 0, "right");
+	check_region(&regions, 3, 6, REGION_BG, -1, 0, 0, "below");
+
+	//
+	// A rectangle, that is partly outside the map.
+	//
+	regions_add_rect(&regions, REGION_INFO, &(s_point ) { 3, 6 }, &(s_point ) { 2, 4 });
+
+	check_region(&regions, 3, 5, REGION_BG, -1, 0, 0, "rect left");
+	check_region(&regions, 3, 7, REGION_INFO, -1, 0, 0, "rect");
+
+	//
+	// Pixels outside the map are background pixels.
+	//
+	check_region(&regions, -1, 0, REGION_BG, -1, 0, 0, "outside");
+	check_region(&regions, 4, 0, REGION_BG, -1, 0, 0, "outside");
+	check_region(&regions, 0, 8, REGION_BG, -1, 0, 0, "outside");
+
+	//
+	// A reset with an other dimension removes the regions.
+	//
+	regions_reset(&regions, &(s_point ) { 3, 3 });
+
+	check_region(&regions, 1, 1, REGION_BG, -1, 0, 0, "resized");
+	check_region(&regions, 2, 6, REGION_BG, -1, 0, 0, "resized outside");
+
+	regions_free(&regions);
+
+	s_area_free(&area);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_regions_exec() {
+
+	test_regions();
+}
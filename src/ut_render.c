@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "render.h"
+
+/******************************************************************************
+ * The function checks the bytes of the current frame of the virtual terminal.
+ *****************************************************************************/
+
+static void check_out(const s_vterm *vterm, const char *exp, const char *msg) {
+
+	ut_check_int(vterm->out_len, strlen(exp), msg);
+
+	ut_check_bool(memcmp(vterm->out, exp, strlen(exp)) == 0, true, msg);
+}
+
+/******************************************************************************
+ * The function checks the flushing of a cell buffer to a virtual terminal.
+ * Only the changed cells are written, the cursor is moved only if necessary
+ * and an escape sequence is written only if the attribute changes.
+ *****************************************************************************/
+
+static void test_render_vterm() {
+	s_render render;
+	s_vterm vterm;
+	s_cells cells;
+
+	vterm_create(&vterm, 2, 4);
+
+	cells_create(&cells, 2, 4, A_NORMAL);
+
+	render_vterm(&render, &vterm);
+
+	s_point dim = render_get_dim(&render);
+
+	ut_check_int(dim.row, 2, "dim row");
+	ut_check_int(dim.col, 4, "dim col");
+
+	//
+	// The first flush writes all cells. The first row starts at the cursor.
+	//
+	ut_check_int(render_flush(&render, &cells), 8, "flush all");
+
+	check_out(&vterm, "    \033[2;1H    ", "out all");
+
+	ut_check_int(vterm.stats.attr_changes, 0, "attr all");
+
+	render_show(&render);
+
+	ut_check_int(vterm.frame_bytes, 20, "frame bytes");
+	ut_check_int(vterm.stats.frames, 1, "frames");
+
+	//
+	// Without changes, nothing is written.
+	//
+	ut_check_int(render_flush(&render, &cells), 0, "flush none");
+
+	check_out(&vterm, "", "out none");
+
+	//
+	// A changed cell with a changed attribute.
+	//
+	cells_set(&cells, 1, 2, L'x', A_BOLD);
+
+	ut_check_int(render_flush(&render, &cells), 1, "flush attr");
+
+	check_out(&vterm, "\033[2;3H\033[0;1mx", "out attr");
+
+	ut_check_int(vterm.stats.attr_changes, 1, "attr changes");
+
+	ut_check_bool(vterm_get(&vterm, 1, 2)->chr == L'x', true, "screen chr");
+	ut_check_int(vterm_get(&vterm, 1, 2)->attr, A_BOLD, "screen attr");
+
+	render_show(&render);
+
+	//
+	// A character is utf8 encoded and the attribute is unchanged.
+	//
+	cells_set(&cells, 0, 3, BLOCK_FULL, A_BOLD);
+
+	render_flush(&render, &cells);
+
+	check_out(&vterm, "\033[1;4H\xe2\x96\x88", "out utf8");
+
+	ut_check_int(vterm.stats.attr_changes, 1, "attr unchanged");
+
+	ut_check_int(vterm.stats.cells, 10, "cells");
+
+	cells_free(&cells);
+
+	vterm_free(&vterm);
+}
+
+/******************************************************************************
+ * The function checks that runs are clipped at the end of the screen.
+ *****************************************************************************/
+
+static void test_render_vterm_clip() {
+	s_vterm vterm;
+
+	const s_cell run[3] = { { L'a', A_NORMAL }, { L'b', A_NORMAL }, { L'c', A_NORMAL } };
+
+	vterm_create(&vterm, 2, 4);
+
+	vterm_put(&vterm, 0, 2, run, 3);
+
+	check_out(&vterm, "\033[1;3Hab", "clip");
+
+	vterm_put(&vterm, 2, 0, run, 3);
+
+	ut_check_int(vterm.stats.cells, 2, "clip cells");
+
+	vterm_free(&vterm);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_render_exec() {
+
+	test_render_vterm();
+
+	test_render_vterm_clip();
+}
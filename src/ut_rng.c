@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "rng.h"
+
+#define UT_RNG_NUM 1000
+
+/******************************************************************************
+ * The function checks that the same seed results in the same sequence and
+ * different seeds in different sequences.
+ *****************************************************************************/
+
+static void test_rng_seed() {
+	s_rng rng_1, rng_2, rng_3;
+
+	rng_seed(&rng_1, 42);
+	rng_seed(&rng_2, 42);
+	rng_seed(&rng_3, 43);
+
+	bool differs = false;
+
+	for (int i = 0; i < UT_RNG_NUM; i++) {
+		const uint64_t next = rng_next(&rng_1);
+
+		ut_check_bool(next == rng_next(&rng_2), true, "same seed");
+
+		if (next != rng_next(&rng_3)) {
+			differs = true;
+		}
+	}
+
+	ut_check_bool(differs, true, "other seed");
+}
+
+/******************************************************************************
+ * The function checks the range of the random ints and that all values are
+ * reached.
+ *****************************************************************************/
+
+static void test_rng_int() {
+	s_rng rng;
+	int count[4] = { 0 };
+
+	rng_seed(&rng, 1);
+
+	for (int i = 0; i < UT_RNG_NUM; i++) {
+		const int value = rng_int(&rng, 4);
+
+		ut_check_bool(value >= 0 && value < 4, true, "range");
+
+		count[value]++;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		ut_check_bool(count[i] > 0, true, "reached");
+	}
+
+	ut_check_int(rng_int(&rng, 1), 0, "single");
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_rng_exec() {
+
+	test_rng_seed();
+
+	test_rng_int();
+}
@@ -38,11 +38,11 @@ static const s_point _size = { 1, 1 };
  * The function ensures that the blocks of the array are all not set.
  *****************************************************************************/
 
-static void check_empty(t_block **blocks, const int row, const int col) {
+static void check_empty(const s_area *area) {
 
-	for (int i = 0; i < row; i++) {
-		for (int j = 0; j < col; j++) {
-			ut_check_int(blocks[i][j], CLR_NONE, "mark");
+	for (int i = 0; i < area->dim.row; i++) {
+		for (int j = 0; j < area->dim.col; j++) {
+			ut_check_int(s_area_block(area, i, j), CLR_NONE, "mark");
 		}
 	}
 }
@@ -65,7 +65,7 @@ static void test_check_squares() {
 	//
 	for (int i = 0; i < RULES_SQUARE_DIM; i++) {
 		for (int j = 0; j < RULES_SQUARE_DIM; j++) {
-			area.blocks[i][j] = RULES_MARKER;
+			s_area_block(&area, i, j) = RULES_MARKER;
 		}
 	}
 
@@ -74,32 +74,94 @@ static void test_check_squares() {
 	//
 	for (int i = 0; i < RULES_SQUARE_DIM; i++) {
 		for (int j = RULES_SQUARE_DIM; j < RULES_SQUARE_DIM * 2; j++) {
-			area.blocks[i][j] = RULES_MARKER;
+			s_area_block(&area, i, j) = RULES_MARKER;
 		}
 	}
 
 	//
 	//  Create the rules and remove the lines.
 	//
-	rules_create_game(&area);
+	s_area_create_squares(&area, RULES_SQUARE_DIM);
 
-	const int count = rules_remove_squares_lines(&area);
+	s_rules rules;
+	rules_create_game(&rules, &area);
+
+	const int count = rules_remove_squares_lines(&rules, &area, NULL, NULL);
 
 	//
 	// Ensure that the result is as expected.
 	//
 	ut_check_int(count, 18, "removed");
 
-	check_empty(area.blocks, _dim.row, _dim.col);
+	check_empty(&area);
 
 	//
 	// Free the allocated area.
 	//
-	rules_free_game(&area);
+	rules_free_game(&rules);
 
 	s_area_free(&area);
 }
 
+/******************************************************************************
+ * The function checks squares with a dimension, that does not divide the
+ * dimension of the area. Only the square at 0/0 is complete, the blocks at
+ * the borders do not form a square.
+ *****************************************************************************/
+
+static void test_check_squares_dim() {
+	const int square_dim = 4;
+
+	//
+	// Create and initialize the area with a 4x4 square and the blocks at the
+	// border.
+	//
+	s_area area;
+	s_area_create(&area, &_dim, &_size);
+	s_area_set_blocks(&area, CLR_NONE);
+
+	for (int i = 0; i < _dim.row - 1; i++) {
+		for (int j = 0; j < _dim.col - 1; j++) {
+			if (i < 2 || j >= square_dim || i >= square_dim) {
+				s_area_block(&area, i, j) = RULES_MARKER;
+			}
+		}
+	}
+
+	s_area_create_squares(&area, square_dim);
+
+	ut_check_int(area.square_num.row * area.square_num.col, 1, "num squares");
+	ut_check_int(area.square_fill[0], 2 * square_dim, "square fill");
+
+	//
+	// Drop the missing part of the square.
+	//
+	s_area drop;
+	s_area_create(&drop, &(s_point ) { 2, square_dim }, &_size);
+	s_area_set_blocks(&drop, RULES_MARKER);
+
+	const s_point idx = { 2, 0 };
+	ut_check_bool(s_area_drop(&area, &idx, &drop, true), true, "drop");
+
+	ut_check_int(area.square_fill[0], square_dim * square_dim, "square full");
+
+	s_rules rules;
+	rules_create_game(&rules, &area);
+
+	const int count = rules_remove_squares_lines(&rules, &area, &drop, &idx);
+
+	ut_check_int(count, square_dim * square_dim, "removed");
+	ut_check_int(area.square_fill[0], 0, "square empty");
+
+	//
+	// Free the allocated areas.
+	//
+	rules_free_game(&rules);
+
+	s_area_free(&drop);
+	s_area_free(&area);
+}
+
 /******************************************************************************
  * The function checks the marking and removing of vertical and horizontal
  * lines.
@@ -126,30 +188,101 @@ static void test_check_lines() {
 	//
 	for (int i = 0; i < _dim.row; i++) {
 
-		area.blocks[1][i] = RULES_MARKER;
+		s_area_block(&area, 1, i) = RULES_MARKER;
 
-		area.blocks[i][2] = RULES_MARKER;
+		s_area_block(&area, i, 2) = RULES_MARKER;
 	}
 
 	//
 	//  Create the rules and remove the squares.
 	//
-	rules_create_game(&area);
+	s_area_create_squares(&area, RULES_SQUARE_DIM);
+
+	s_rules rules;
+	rules_create_game(&rules, &area);
 
-	const int count = rules_remove_squares_lines(&area);
+	const int count = rules_remove_squares_lines(&rules, &area, NULL, NULL);
 
 	//
 	// Ensure that the result is as expected.
 	//
 	ut_check_int(count, 11, "removed");
 
-	check_empty(area.blocks, _dim.row, _dim.col);
+	check_empty(&area);
 
 	//
 	// Free the allocated area.
 	//
-	rules_free_game(&area);
+	rules_free_game(&rules);
+
+	s_area_free(&area);
+}
+
+/******************************************************************************
+ * The function checks that the lines rules only consider the rows and columns
+ * of the last drop. The drop completes row 1, while row 4 is complete, but
+ * not touched.
+ *****************************************************************************/
+
+static void test_check_lines_drop() {
+
+	//
+	// Create and initialize the area
+	//
+	s_area area;
+	s_area_create(&area, &_dim, &_size);
+	s_area_set_blocks(&area, CLR_NONE);
+
+	for (int i = 0; i < _dim.col; i++) {
+		s_area_block(&area, 4, i) = RULES_MARKER;
+
+		if (i > 1) {
+			s_area_block(&area, 1, i) = RULES_MARKER;
+		}
+	}
+
+	s_area_sync(&area);
+
+	//
+	// Create the drop area, which fills the missing blocks of row 1.
+	//
+	s_area drop;
+	s_area_create(&drop, &(s_point ) { 1, 2 }, &_size);
+	s_area_set_blocks(&drop, RULES_MARKER);
+
+	const s_point idx = { 1, 0 };
+	ut_check_bool(s_area_drop(&area, &idx, &drop, true), true, "drop");
+
+	ut_check_int(area.row_fill[1], _dim.col, "row fill");
+	ut_check_int(area.col_fill[0], 2, "col fill");
+
+	s_rules rules;
+	rules_create_game(&rules, &area);
+
+	const int count = rules_remove_lines(&rules, &area, &drop, &idx);
+
+	//
+	// Only the touched row is removed.
+	//
+	ut_check_int(count, _dim.col, "removed");
+
+	ut_check_int(area.row_fill[1], 0, "row fill removed");
+	ut_check_int(area.row_fill[4], _dim.col, "row fill untouched");
+	ut_check_int(area.col_fill[0], 1, "col fill removed");
+
+	//
+	// A full check finds the untouched row.
+	//
+	ut_check_int(rules_remove_lines(&rules, &area, NULL, NULL), _dim.col, "full check");
 
+	check_empty(&area);
+
+	//
+	// Free the allocated areas.
+	//
+	rules_free_game(&rules);
+
+	s_area_free(&drop);
 	s_area_free(&area);
 }
 
@@ -174,48 +307,138 @@ static void test_check_neighbors() {
 	s_area_create(&area, &_dim, &_size);
 	s_area_set_blocks(&area, 0);
 
-	area.blocks[0][0] = CLR_RED__N;
-	area.blocks[0][1] = CLR_RED__N;
+	s_area_block(&area, 0, 0) = CLR_RED__N;
+	s_area_block(&area, 0, 1) = CLR_RED__N;
 
-	area.blocks[1][1] = CLR_RED__N;
+	s_area_block(&area, 1, 1) = CLR_RED__N;
 
-	area.blocks[2][1] = CLR_RED__N;
-	area.blocks[2][2] = CLR_BLUE_N;
-	area.blocks[2][3] = CLR_BLUE_N;
-	area.blocks[2][4] = CLR_BLUE_N;
-	area.blocks[2][5] = CLR_BLUE_N;
+	s_area_block(&area, 2, 1) = CLR_RED__N;
+	s_area_block(&area, 2, 2) = CLR_BLUE_N;
+	s_area_block(&area, 2, 3) = CLR_BLUE_N;
+	s_area_block(&area, 2, 4) = CLR_BLUE_N;
+	s_area_block(&area, 2, 5) = CLR_BLUE_N;
 
-	area.blocks[3][2] = CLR_BLUE_N;
+	s_area_block(&area, 3, 2) = CLR_BLUE_N;
 
-	area.blocks[4][2] = CLR_BLUE_N;
-	area.blocks[4][3] = CLR_BLUE_N;
-	area.blocks[4][4] = CLR_BLUE_N;
-	area.blocks[4][5] = CLR_BLUE_N;
+	s_area_block(&area, 4, 2) = CLR_BLUE_N;
+	s_area_block(&area, 4, 3) = CLR_BLUE_N;
+	s_area_block(&area, 4, 4) = CLR_BLUE_N;
+	s_area_block(&area, 4, 5) = CLR_BLUE_N;
 
-	area.blocks[5][2] = CLR_BLUE_N;
+	s_area_block(&area, 5, 2) = CLR_BLUE_N;
 
 	//
 	// Create the rules and remove the neighbors.
 	//
-	rules_create_game(&area);
+	s_area_sync(&area);
+
+	s_rules rules;
+	rules_create_game(&rules, &area);
 
-	const int count = rules_remove_neighbors(&area);
+	const int count = rules_remove_neighbors(&rules, &area, NULL, NULL);
 
 	//
 	// Ensure that the result is as expected.
 	//
 	ut_check_int(count, 14, "removed");
 
-	check_empty(area.blocks, _dim.row, _dim.col);
+	check_empty(&area);
 
 	//
 	// Free the allocated areas.
 	//
-	rules_free_game(&area);
+	rules_free_game(&rules);
 
 	s_area_free(&area);
 }
 
+/******************************************************************************
+ * The function checks the neighbors on an area, that is wider than high, so
+ * columns beyond the number of rows have to be reached. The small components
+ * are not removed, the second call ensures that the visited blocks are reset.
+ *
+ * --YY----
+ * XXXXXXXX
+ *****************************************************************************/
+
+static void test_check_neighbors_wide() {
+
+	s_area area;
+	s_area_create(&area, &(s_point ) { 2, 8 }, &_size);
+	s_area_set_blocks(&area, CLR_NONE);
+
+	s_area_block(&area, 0, 2) = CLR_RED__N;
+	s_area_block(&area, 0, 3) = CLR_RED__N;
+
+	for (int i = 0; i < area.dim.col; i++) {
+		s_area_block(&area, 1, i) = CLR_BLUE_N;
+	}
+
+	s_area_sync(&area);
+
+	s_rules rules;
+	rules_create_game(&rules, &area);
+
+	ut_check_int(rules_remove_neighbors(&rules, &area, NULL, NULL), 8, "removed");
+
+	ut_check_int(rules_remove_neighbors(&rules, &area, NULL, NULL), 0, "small component");
+
+	ut_check_int(s_area_block(&area, 0, 2), CLR_RED__N, "not removed");
+
+	rules_free_game(&rules);
+
+	s_area_free(&area);
+}
+
+/******************************************************************************
+ * The function checks that only components with blocks of the footprint of
+ * the last drop are removed. The blue component is inside the drop area, but
+ * not part of its footprint (x are the dropped blocks).
+ *
+ * xBBBB-
+ * xx----
+ * Y-----
+ * Y-----
+ *****************************************************************************/
+
+static void test_check_neighbors_drop() {
+
+	s_area area;
+	s_area_create(&area, &_dim, &_size);
+	s_area_set_blocks(&area, CLR_NONE);
+
+	for (int i = 1; i < 5; i++) {
+		s_area_block(&area, 0, i) = CLR_BLUE_N;
+	}
+
+	s_area_block(&area, 2, 0) = CLR_RED__N;
+	s_area_block(&area, 3, 0) = CLR_RED__N;
+
+	s_area_sync(&area);
+
+	s_area drop;
+	s_area_create(&drop, &(s_point ) { 2, 2 }, &_size);
+	s_area_set_blocks(&drop, CLR_RED__N);
+
+	s_area_block(&drop, 0, 1) = CLR_NONE;
+	s_area_sync(&drop);
+
+	const s_point idx = { 0, 0 };
+	ut_check_bool(s_area_drop(&area, &idx, &drop, true), true, "drop");
+
+	s_rules rules;
+	rules_create_game(&rules, &area);
+
+	ut_check_int(rules_remove_neighbors(&rules, &area, &drop, &idx), 5, "removed");
+
+	ut_check_int(s_area_block(&area, 0, 1), CLR_BLUE_N, "not in footprint");
+
+	rules_free_game(&rules);
+
+	s_area_free(&drop);
+	s_area_free(&area);
+}
+
 /******************************************************************************
  * The function is the a wrapper, that triggers the internal unit tests.
  *****************************************************************************/
@@ -224,7 +447,15 @@ void ut_rules_exec() {
 
 	test_check_squares();
 
+	test_check_squares_dim();
+
 	test_check_lines();
 
+	test_check_lines_drop();
+
 	test_check_neighbors();
+
+	test_check_neighbors_wide();
+
+	test_check_neighbors_drop();
 }
@@ -37,7 +37,10 @@ static void test_s_area_copy() {
 	s_point_set(&from.size, 3, 4);
 	s_point_set(&from.pos, 5, 6);
 
-	from.blocks = NULL;
+	from.blocks.data = NULL;
+	from.bits.words = NULL;
+	from.row_fill = NULL;
+	from.col_fill = NULL;
 
 	s_area_copy(&from, &to);
 
@@ -45,9 +48,13 @@ static void test_s_area_copy() {
 	ut_check_s_point(&to.size, &(s_point ) { 3, 4 }, "checking size");
 	ut_check_s_point(&to.pos, &(s_point ) { 5, 6 }, "checking pos");
 
-	if (to.blocks != NULL) {
+	if (to.blocks.data != NULL) {
 		log_exit_str("Block is not null!");
 	}
+
+	if (to.bits.words != NULL) {
+		log_exit_str("Bits is not null!");
+	}
 }
 
 /******************************************************************************
@@ -70,7 +77,7 @@ static void test_s_area_copy_deep() {
 
 	for (int i = 0; i < from.dim.row; i++) {
 		for (int j = 0; j < from.dim.col; j++) {
-			from.blocks[i][j] = 10 * i + j;
+			s_area_block(&from, i, j) = 10 * i + j;
 		}
 	}
 
@@ -88,7 +95,7 @@ static void test_s_area_copy_deep() {
 
 	for (int i = 0; i < to.dim.row; i++) {
 		for (int j = 0; j < to.dim.col; j++) {
-			ut_check_int(to.blocks[i][j], from.blocks[i][j], "block");
+			ut_check_int(s_area_block(&to, i, j), s_area_block(&from, i, j), "block");
 		}
 	}
 
@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "sim.h"
+#include "rules.h"
+
+/******************************************************************************
+ * The game area has 2 rows and 2 columns, so two single blocks complete a
+ * line.
+ *****************************************************************************/
+
+static const s_point _game_dim = { 2, 2 };
+
+static const s_point _block = { 0, 0 };
+
+/******************************************************************************
+ * The function checks the parsing of the policy names.
+ *****************************************************************************/
+
+static void test_sim_policy_parse() {
+
+	ut_check_int(sim_policy_parse("random"), SIM_POLICY_RANDOM, "random");
+	ut_check_int(sim_policy_parse("first-fit"), SIM_POLICY_FIRST_FIT, "first-fit");
+	ut_check_int(sim_policy_parse("greedy"), SIM_POLICY_GREEDY, "greedy");
+	ut_check_int(sim_policy_parse("solver"), SIM_POLICY_SOLVER, "solver");
+}
+
+/******************************************************************************
+ * The function checks the moves of the first fit and the greedy policy. A
+ * block is dropped at the lower right corner, so the first legal position
+ * removes nothing, while the second completes the right column.
+ *****************************************************************************/
+
+static void test_sim_select_move() {
+	s_game_cfg game_cfg;
+	s_sim sim;
+	int home_idx;
+	s_point idx;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	for (int i = 0; i < SIM_POLICY_NUM; i++) {
+		const s_sim_opts opts = { .policy = i, .beam = SOLVER_BEAM_DEFAULT };
+
+		sim_create(&sim, &game_cfg, &opts);
+
+		engine_apply_move(&sim.engine, 0, &(s_point ) { 1, 1 });
+
+		ut_check_bool(sim_select_move(&sim, &home_idx, &idx), true, "select");
+		ut_check_int(home_idx, 1, "home idx");
+
+		if (i == SIM_POLICY_FIRST_FIT) {
+			ut_check_s_point(&idx, &(s_point ) { 0, 0 }, "first fit");
+
+		} else if (i == SIM_POLICY_GREEDY) {
+			ut_check_s_point(&idx, &(s_point ) { 0, 1 }, "greedy");
+			ut_check_int(engine_apply_move(&sim.engine, home_idx, &idx), 2, "greedy removed");
+
+		} else {
+			ut_check_bool(engine_apply_move(&sim.engine, home_idx, &idx) != ENGINE_ILLEGAL, true, "random legal");
+		}
+
+		sim_free(&sim);
+	}
+}
+
+/******************************************************************************
+ * The function checks complete games, the end reasons and the statistics.
+ *****************************************************************************/
+
+static void test_sim_play_game() {
+	s_game_cfg game_cfg;
+	s_sim sim;
+	s_sim_game game;
+	s_sim_stats stats;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, ut_rules_keep);
+
+	const s_sim_opts opts = { .policy = SIM_POLICY_RANDOM };
+
+	sim_create(&sim, &game_cfg, &opts);
+
+	sim_stats_create(&stats, 2);
+
+	//
+	// The game area is filled after 4 turns.
+	//
+	sim_play_game(&sim, UT_SEED, 0, &game);
+
+	ut_check_int(game.turns, 4, "turns");
+	ut_check_int(game.score, 0, "score");
+	ut_check_int(game.end, SIM_END_NO_FIT, "end no fit");
+
+	sim_stats_add(&stats, 0, &game);
+
+	//
+	// The game ends after the maximum number of turns.
+	//
+	sim_play_game(&sim, UT_SEED, 2, &game);
+
+	ut_check_int(game.turns, 2, "max turns");
+	ut_check_int(game.end, SIM_END_MAX_TURNS, "end max turns");
+
+	sim_stats_add(&stats, 1, &game);
+
+	ut_check_int(stats.games, 2, "stats games");
+	ut_check_int(stats.turns, 6, "stats turns");
+	ut_check_int(stats.turns_min, 2, "stats turns min");
+	ut_check_int(stats.turns_max, 4, "stats turns max");
+	ut_check_int(stats.ends[SIM_END_NO_FIT], 1, "stats no fit");
+	ut_check_int(stats.ends[SIM_END_MAX_TURNS], 1, "stats max turns");
+
+	sim_stats_free(&stats);
+
+	sim_free(&sim);
+}
+
+/******************************************************************************
+ * The function checks that the results of a parallel run do not depend on the
+ * number of threads and that the statistics of the workers are merged.
+ *****************************************************************************/
+
+static void test_sim_run() {
+	s_game_cfg game_cfg;
+	s_sim_stats stats_1, stats_n;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	s_point_set(&game_cfg.game_dim, 4, 4);
+
+	const int num_games = 3 * SIM_CHUNK + 1;
+
+	sim_stats_create(&stats_1, num_games);
+	sim_stats_create(&stats_n, num_games);
+
+	//
+	// Single blocks may never fill the game area, so the games are limited.
+	//
+	const s_sim_opts opts = { .policy = SIM_POLICY_RANDOM };
+
+	sim_run(&game_cfg, &opts, UT_SEED, 20, 1, &stats_1);
+	sim_run(&game_cfg, &opts, UT_SEED, 20, 3, &stats_n);
+
+	ut_check_int(stats_n.games, num_games, "games");
+	ut_check_int(stats_n.ends[SIM_END_MAX_TURNS], stats_1.ends[SIM_END_MAX_TURNS], "ends");
+	ut_check_int(stats_n.turns, stats_1.turns, "turns");
+	ut_check_int(stats_n.turns_min, stats_1.turns_min, "turns min");
+	ut_check_int(stats_n.turns_max, stats_1.turns_max, "turns max");
+
+	for (int i = 0; i < num_games; i++) {
+		ut_check_int(stats_n.scores[i], stats_1.scores[i], "score");
+	}
+
+	sim_stats_free(&stats_1);
+	sim_stats_free(&stats_n);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_sim_exec() {
+
+	test_sim_policy_parse();
+
+	test_sim_select_move();
+
+	test_sim_play_game();
+
+	test_sim_run();
+}
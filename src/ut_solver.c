@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ut_utils.h"
+#include "solver.h"
+#include "rules.h"
+
+/******************************************************************************
+ * The game area has 2 rows and 2 columns.
+ *****************************************************************************/
+
+static const s_point _game_dim = { 2, 2 };
+
+static const s_point _block = { 0, 0 };
+
+/******************************************************************************
+ * The function checks that the hash depends on the blocks and the used home
+ * areas.
+ *****************************************************************************/
+
+static void test_solver_hash() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+	s_solver solver;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	solver_create(&solver, &engine, &eval_weights_greedy, SOLVER_BEAM_DEFAULT, false);
+
+	s_area *area = &engine.game_area;
+
+	const uint64_t empty = solver_hash(&solver, area, 0);
+
+	ut_check_bool(solver_hash(&solver, area, 1) != empty, true, "used");
+
+	s_area_block(area, 0, 1) = CLR_RED__N;
+	s_area_sync(area);
+
+	const uint64_t red = solver_hash(&solver, area, 0);
+
+	ut_check_bool(red != empty, true, "block");
+
+	s_area_block(area, 0, 1) = CLR_BLUE_N;
+	s_area_sync(area);
+
+	ut_check_bool(solver_hash(&solver, area, 0) != red, true, "color");
+
+	s_area_block(area, 0, 1) = CLR_NONE;
+	s_area_sync(area);
+
+	ut_check_bool(solver_hash(&solver, area, 0) == empty, true, "removed");
+
+	solver_free(&solver);
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function checks that the solver finds the best ordering. The game area
+ * contains a block in the lower left corner. The first home area is a single
+ * block and the second a horizontal bar:
+ *
+ * - The bar in the upper row removes the row and the left column (3 blocks).
+ *   The single block removes nothing afterwards.
+ * - The single block in the left column removes the column (2 blocks) and
+ *   the bar removes a row afterwards (2 blocks).
+ *
+ * The greedy evaluation selects the bar, the solver the single block.
+ *****************************************************************************/
+
+static void test_solver_best_move() {
+	s_game_cfg game_cfg;
+	s_engine engine;
+	s_eval eval;
+	s_solver solver;
+	s_eval_move move;
+
+	ut_game_cfg(&game_cfg, &_game_dim, &_block, rules_remove_lines);
+
+	engine_create(&engine, &game_cfg, UT_SEED);
+
+	s_area_block(&engine.game_area, 1, 0) = CLR_RED__N;
+	s_area_sync(&engine.game_area);
+
+	//
+	// Set the bar as the second home area.
+	//
+	s_engine_home *home = &engine.home[1];
+
+	s_area_set_blocks(&home->area, CLR_NONE);
+
+	s_area_block(&home->area, 1, 0) = CLR_RED__N;
+	s_area_block(&home->area, 1, 1) = CLR_RED__N;
+	s_area_sync(&home->area);
+
+	bitboard_from_blocks(&home->norm, &home->area.blocks, &home->area.dim);
+	bitboard_normalize(&home->norm, &home->area.dim, &home->norm_dim);
+
+	eval_create(&eval, &game_cfg);
+
+	ut_check_bool(eval_best_move(&eval, &engine, &eval_weights_greedy, &move), true, "greedy found");
+	ut_check_int(move.home_idx, 1, "greedy home");
+	ut_check_int(move.score, 3, "greedy score");
+
+	eval_free(&eval);
+
+	solver_create(&solver, &engine, &eval_weights_greedy, SOLVER_BEAM_DEFAULT, false);
+
+	ut_check_bool(solver_best_move(&solver, &engine, &move), true, "solver found");
+	ut_check_int(move.home_idx, 0, "solver home");
+	ut_check_int(move.removed, 2, "solver removed");
+	ut_check_int(move.score, 4, "solver score");
+
+	//
+	// The move of the solver is legal.
+	//
+	ut_check_int(engine_apply_move(&engine, move.home_idx, &move.idx), 2, "apply");
+
+	solver_free(&solver);
+
+	engine_free(&engine);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_solver_exec() {
+
+	test_solver_hash();
+
+	test_solver_best_move();
+}
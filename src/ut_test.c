@@ -27,6 +27,19 @@
 
 #include "ut_s_area.h"
 #include "ut_rules.h"
+#include "ut_bitboard.h"
+#include "ut_blocks.h"
+#include "ut_engine.h"
+#include "ut_rng.h"
+#include "ut_sim.h"
+#include "ut_eval.h"
+#include "ut_solver.h"
+#include "ut_hint.h"
+#include "ut_anim.h"
+#include "ut_loop.h"
+#include "ut_cells.h"
+#include "ut_render.h"
+#include "ut_regions.h"
 #include "ut_common.h"
 #include "ut_file_system.h"
 #include "ut_info_area.h"
@@ -50,6 +63,32 @@ int main() {
 
 	ut_rules_exec();
 
+	ut_bitboard_exec();
+
+	ut_blocks_exec();
+
+	ut_engine_exec();
+
+	ut_rng_exec();
+
+	ut_sim_exec();
+
+	ut_eval_exec();
+
+	ut_solver_exec();
+
+	ut_hint_exec();
+
+	ut_anim_exec();
+
+	ut_loop_exec();
+
+	ut_cells_exec();
+
+	ut_render_exec();
+
+	ut_regions_exec();
+
 	ut_common_exec();
 
 	ut_file_system_exec();
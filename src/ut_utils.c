@@ -22,7 +22,7 @@
  * SOFTWARE.
  */
 
-#include "common.h"
+#include "ut_utils.h"
 
 /******************************************************************************
  * The function checks whether an int parameter has the expected value or not.
@@ -103,3 +103,74 @@ void ut_check_wstr(const wchar_t *cur, const wchar_t *exp, const char *msg) {
 
 	log_debug("[%s] OK current: '%ls'", msg, cur);
 }
+
+/******************************************************************************
+ * The game configuration of the engine tests: the home areas are single
+ * blocks, so the moves are easy to predict. The position of the block in the
+ * drop area is set by ut_game_cfg(). A position other than the upper left
+ * corner requires the normalization.
+ *****************************************************************************/
+
+static const s_point _ut_drop_dim = { 2, 2 };
+
+static const s_point _ut_size = { 1, 1 };
+
+static s_point _ut_block = { 0, 0 };
+
+/******************************************************************************
+ * The test does not require game data.
+ *****************************************************************************/
+
+static void ut_set_data(s_game_data *game_data UNUSED, const char *data UNUSED) {
+}
+
+/******************************************************************************
+ * The function fills a home area with a single block.
+ *****************************************************************************/
+
+static void ut_init_single(const s_game_cfg *game_cfg, const s_game_data *game_data UNUSED, s_rng *rng UNUSED, s_blocks *blocks, s_bitboard *norm, s_point *norm_dim) {
+
+	blocks_set(blocks, &game_cfg->drop_dim, CLR_NONE);
+
+	blocks_at(blocks, _ut_block.row, _ut_block.col) = CLR_RED__N;
+
+	bitboard_from_blocks(norm, blocks, &game_cfg->drop_dim);
+
+	bitboard_normalize(norm, &game_cfg->drop_dim, norm_dim);
+}
+
+/******************************************************************************
+ * The rules function removes no blocks, so the game area is filled up.
+ *****************************************************************************/
+
+int ut_rules_keep(s_rules *rules UNUSED, s_area *area UNUSED, const s_area *drop_area UNUSED, const s_point *idx UNUSED) {
+	return 0;
+}
+
+/******************************************************************************
+ * The function initializes a game configuration for the tests, with the
+ * lines type, two home areas and the given dimension of the game area. The
+ * home areas are filled with a single block at the given position and the
+ * blocks are removed with the given rules function.
+ *****************************************************************************/
+
+void ut_game_cfg(s_game_cfg *game_cfg, const s_point *game_dim, const s_point *block, int (*fct_ptr_rules_remove)(s_rules*, s_area*, const s_area*, const s_point*)) {
+
+	memset(game_cfg, 0, sizeof(s_game_cfg));
+
+	game_cfg->type = TYPE_LINES;
+
+	s_point_copy(&game_cfg->game_dim, game_dim);
+	s_point_copy(&game_cfg->game_size, &_ut_size);
+
+	s_point_copy(&game_cfg->drop_dim, &_ut_drop_dim);
+	s_point_copy(&game_cfg->home_size, &_ut_size);
+
+	game_cfg->home_num = 2;
+
+	s_point_copy(&_ut_block, block);
+
+	game_cfg->fct_ptr_set_data = ut_set_data;
+	game_cfg->fct_ptr_rules_remove = fct_ptr_rules_remove;
+	game_cfg->fct_ptr_init_random = ut_init_single;
+}
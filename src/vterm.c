@@ -0,0 +1,270 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+
+#include "vterm.h"
+#include "colors.h"
+
+/******************************************************************************
+ * Definitions.
+ *****************************************************************************/
+
+#define OUT_SIZE 4096
+
+#define SEQ_SIZE 64
+
+/******************************************************************************
+ * The function creates a virtual terminal with a given dimension. The screen
+ * is empty, the cursor is at the upper left corner and the attribute is the
+ * default attribute.
+ *****************************************************************************/
+
+void vterm_create(s_vterm *vterm, const int rows, const int cols) {
+
+	log_debug("Create vterm: %d/%d", rows, cols);
+
+	vterm->dim.row = rows;
+	vterm->dim.col = cols;
+
+	vterm->screen = xmalloc(sizeof(s_cell) * (rows * cols > 0 ? rows * cols : 1));
+
+	for (int i = 0; i < rows * cols; i++) {
+		vterm->screen[i].chr = L' ';
+		vterm->screen[i].attr = A_NORMAL;
+	}
+
+	s_point_set(&vterm->cursor, 0, 0);
+
+	vterm->attr = A_NORMAL;
+
+	vterm->out = xmalloc(OUT_SIZE);
+	vterm->out_len = 0;
+	vterm->out_size = OUT_SIZE;
+
+	vterm->frame_bytes = 0;
+
+	vterm->stats = (s_vterm_stats ) { 0, 0, 0, 0 };
+}
+
+/******************************************************************************
+ * The function frees the allocated memory.
+ *****************************************************************************/
+
+void vterm_free(s_vterm *vterm) {
+
+	free(vterm->screen);
+	vterm->screen = NULL;
+
+	free(vterm->out);
+	vterm->out = NULL;
+}
+
+/******************************************************************************
+ * The function appends bytes to the output of the current frame. The buffer
+ * grows if necessary.
+ *****************************************************************************/
+
+static void vterm_out(s_vterm *vterm, const char *bytes, const int len) {
+
+	if (vterm->out_len + len > vterm->out_size) {
+
+		while (vterm->out_len + len > vterm->out_size) {
+			vterm->out_size *= 2;
+		}
+
+		char *out = realloc(vterm->out, vterm->out_size);
+		if (out == NULL) {
+			log_exit("Unable to allocate: %d bytes of memory!", vterm->out_size);
+		}
+
+		vterm->out = out;
+	}
+
+	memcpy(&vterm->out[vterm->out_len], bytes, len);
+
+	vterm->out_len += len;
+
+	vterm->stats.bytes += len;
+}
+
+/******************************************************************************
+ * The function moves the cursor. The escape sequence is only necessary, if
+ * the cursor is not already at the position. The sequence is 1-based.
+ *****************************************************************************/
+
+static void vterm_move(s_vterm *vterm, const int row, const int col) {
+	char seq[SEQ_SIZE];
+
+	if (vterm->cursor.row == row && vterm->cursor.col == col) {
+		return;
+	}
+
+	const int len = snprintf(seq, SEQ_SIZE, "\033[%d;%dH", row + 1, col + 1);
+
+	vterm_out(vterm, seq, len);
+
+	s_point_set(&vterm->cursor, row, col);
+}
+
+/******************************************************************************
+ * The function sets the attribute. If it changes, a select graphic rendition
+ * sequence is written, which resets the attributes and sets the flags and the
+ * colors of the color pair. A color pair without colors keeps the default
+ * colors of the terminal.
+ *****************************************************************************/
+
+static void vterm_attr(s_vterm *vterm, const attr_t attr) {
+	char seq[SEQ_SIZE];
+	short fg, bg;
+
+	if (vterm->attr == attr) {
+		return;
+	}
+
+	int len = snprintf(seq, SEQ_SIZE, "\033[0");
+
+	if (attr & A_BOLD) {
+		len += snprintf(&seq[len], SEQ_SIZE - len, ";1");
+	}
+
+	if (attr & A_UNDERLINE) {
+		len += snprintf(&seq[len], SEQ_SIZE - len, ";4");
+	}
+
+	if (attr & A_BLINK) {
+		len += snprintf(&seq[len], SEQ_SIZE - len, ";5");
+	}
+
+	if (attr & A_REVERSE) {
+		len += snprintf(&seq[len], SEQ_SIZE - len, ";7");
+	}
+
+	if (colors_pair_content(PAIR_NUMBER(attr), &fg, &bg)) {
+		len += snprintf(&seq[len], SEQ_SIZE - len, ";38;5;%d;48;5;%d", fg, bg);
+	}
+
+	len += snprintf(&seq[len], SEQ_SIZE - len, "m");
+
+	vterm_out(vterm, seq, len);
+
+	vterm->attr = attr;
+
+	vterm->stats.attr_changes++;
+}
+
+/******************************************************************************
+ * The function writes a character utf8 encoded. The encoding does not depend
+ * on the locale.
+ *****************************************************************************/
+
+static void vterm_char(s_vterm *vterm, const wchar_t chr) {
+	char bytes[4];
+	int len;
+
+	const unsigned long c = (unsigned long) chr;
+
+	if (c < 0x80) {
+		bytes[0] = (char) c;
+		len = 1;
+
+	} else if (c < 0x800) {
+		bytes[0] = (char) (0xC0 | (c >> 6));
+		bytes[1] = (char) (0x80 | (c & 0x3F));
+		len = 2;
+
+	} else if (c < 0x10000) {
+		bytes[0] = (char) (0xE0 | (c >> 12));
+		bytes[1] = (char) (0x80 | ((c >> 6) & 0x3F));
+		bytes[2] = (char) (0x80 | (c & 0x3F));
+		len = 3;
+
+	} else {
+		bytes[0] = (char) (0xF0 | (c >> 18));
+		bytes[1] = (char) (0x80 | ((c >> 12) & 0x3F));
+		bytes[2] = (char) (0x80 | ((c >> 6) & 0x3F));
+		bytes[3] = (char) (0x80 | (c & 0x3F));
+		len = 4;
+	}
+
+	vterm_out(vterm, bytes, len);
+}
+
+/******************************************************************************
+ * The function writes a run of cells to the screen, starting at a position.
+ * Like mvwadd_wchnstr() it does not wrap and ignores cells outside the
+ * screen. The cursor is moved, only if the run does not start at the cursor.
+ *****************************************************************************/
+
+void vterm_put(s_vterm *vterm, const int row, const int col, const s_cell *cells, const int num) {
+
+	if (row < 0 || row >= vterm->dim.row || col < 0) {
+		return;
+	}
+
+	const int end = col + num < vterm->dim.col ? col + num : vterm->dim.col;
+
+	if (col >= end) {
+		return;
+	}
+
+	vterm_move(vterm, row, col);
+
+	for (int i = col; i < end; i++) {
+		const s_cell *cell = &cells[i - col];
+
+		vterm_attr(vterm, cell->attr);
+
+		vterm_char(vterm, cell->chr);
+
+		*vterm_get(vterm, row, i) = *cell;
+	}
+
+	//
+	// After the last column of the screen, the cursor column is not valid,
+	// so the next run requires a move.
+	//
+	vterm->cursor.col = end;
+
+	vterm->stats.cells += end - col;
+}
+
+/******************************************************************************
+ * The function shows the frame. Like the ncurses backend, the cursor is moved
+ * to the upper left corner. The bytes of the frame are kept for the
+ * statistics and the output is reset for the next frame.
+ *****************************************************************************/
+
+void vterm_show(s_vterm *vterm) {
+
+	vterm_move(vterm, 0, 0);
+
+	vterm->frame_bytes = vterm->out_len;
+
+	vterm->out_len = 0;
+
+	vterm->stats.frames++;
+
+	log_debug("Frame: %ld bytes: %d", vterm->stats.frames, vterm->frame_bytes);
+}